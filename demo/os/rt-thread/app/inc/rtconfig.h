@@ -83,5 +83,9 @@
 #define RT_USING_DEVICE_IPC
 // <bool name="RT_USING_SERIAL" description="Using Serial" default="true" />
 #define RT_USING_SERIAL
+// <bool name="RT_USING_UART1_DMA_TX" description="Using DMA to transmit the EasyLogger output on UART1" default="false" />
+//#define RT_USING_UART1_DMA_TX
+// <integer name="RT_UART1_DMA_TX_BUFFER_SIZE" description="The size of each UART1 DMA transmit buffer" default="512" />
+#define RT_UART1_DMA_TX_BUFFER_SIZE	512
 
 #endif
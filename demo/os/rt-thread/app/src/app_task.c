@@ -45,6 +45,8 @@ void thread_entry_sys_monitor(void* parameter)
         if(get_system_status() == SYSTEM_STATUS_RUN){
             /* elog test */
             test_elog();
+            /* flush the pending log, such as the repeated log counter */
+            elog_flush();
             LED_RUN_ON;
             rt_thread_delay(DELAY_SYS_RUN_LED_ON);
             LED_RUN_OFF;
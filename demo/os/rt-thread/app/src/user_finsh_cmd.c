@@ -10,6 +10,12 @@
 #include <finsh.h>
 #include "cpuusage.h"
 #include "elog.h"
+#ifdef ELOG_USING_OUTPUT_FLASH
+#include "elog_flash.h"
+#endif
+#ifdef RT_USING_UART1_DMA_TX
+#include "usart.h"
+#endif
 
 static void reboot(uint8_t argc, char **argv) {
     NVIC_SystemReset();
@@ -24,6 +30,14 @@ static void get_cpuusage(void) {
 }
 MSH_CMD_EXPORT(get_cpuusage, Get control board cpu usage);
 
+#ifdef RT_USING_UART1_DMA_TX
+static void get_uart1_dma(void) {
+    rt_kprintf("The UART1 DMA buffer usage is %d%%, %d logs are dropped.\n", rt_hw_usart1_dma_get_usage(),
+            rt_hw_usart1_dma_get_dropped());
+}
+MSH_CMD_EXPORT(get_uart1_dma, Get UART1 DMA buffer usage and dropped log number);
+#endif
+
 static void elog(uint8_t argc, char **argv) {
     if (argc > 1) {
         if (!strcmp(argv[1], "on") || !strcmp(argv[1], "ON")) {
@@ -77,3 +91,90 @@ static void elog_kw(uint8_t argc, char **argv) {
     }
 }
 MSH_CMD_EXPORT(elog_kw, Set EasyLogger filter keyword);
+
+#ifdef ELOG_USING_TAG_TABLE
+static void elog_tag_lvl(uint8_t argc, char **argv) {
+    if (argc > 2) {
+        if ((atoi(argv[2]) <= ELOG_LVL_VERBOSE) && (atoi(argv[2]) >= 0)) {
+            if (!elog_set_tag_lvl(argv[1], atoi(argv[2]))) {
+                rt_kprintf("The tag table is full. Max is %d.\n", ELOG_TAG_MAX_NUM);
+            }
+        } else {
+            rt_kprintf("Please input correct level(0-5).\n");
+        }
+    } else if (argc > 1) {
+        elog_set_tag_lvl(argv[1], ELOG_TAG_LVL_DEFAULT);
+    } else {
+        rt_kprintf("Please input tag and level.\n");
+    }
+}
+MSH_CMD_EXPORT(elog_tag_lvl, Set EasyLogger tag level [tag] [level]);
+#endif
+
+#ifdef ELOG_USING_SAMPLE
+static void elog_sample(uint8_t argc, char **argv) {
+    if (argc > 2) {
+        if (rt_strlen(argv[1]) > ELOG_FILTER_TAG_MAX_LEN) {
+            rt_kprintf("The tag length is too long. Max is %d.\n", ELOG_FILTER_TAG_MAX_LEN);
+        } else if (!elog_set_sample(argv[1], argc > 5 ? argv[5] : NULL, argc > 4 ? atol(argv[4]) : 0,
+                atol(argv[2]), argc > 3 ? atol(argv[3]) : 0)) {
+            rt_kprintf("The sampling rule is full. Max is %d.\n", ELOG_SAMPLE_RULE_MAX);
+        }
+    } else {
+        rt_kprintf("Please input tag, rate, [period], [line] and [file].\n");
+    }
+}
+MSH_CMD_EXPORT(elog_sample, Set EasyLogger sampling [tag] [rate] [period] [line] [file]);
+#endif
+
+#ifdef ELOG_USING_FLIGHT_RECORDER
+static void elog_flight(uint8_t argc, char **argv) {
+    if (argc > 1) {
+        elog_flight_dump(atoi(argv[1]));
+    } else {
+        elog_flight_dump(0);
+    }
+}
+MSH_CMD_EXPORT(elog_flight, Dump EasyLogger flight recorder [size]);
+#endif
+
+#ifdef ELOG_USING_LATENCY
+static void elog_latency(uint8_t argc, char **argv) {
+    if (argc > 1) {
+        if (!rt_strcmp(argv[1], "clean")) {
+            elog_latency_clean();
+        } else {
+            rt_kprintf("Please input elog_latency or elog_latency clean.\n");
+        }
+    } else {
+        elog_latency_dump();
+    }
+}
+MSH_CMD_EXPORT(elog_latency, Dump EasyLogger latency histogram [clean]);
+#endif
+
+#ifdef ELOG_USING_OUTPUT_FLASH
+static void elog_flash(uint8_t argc, char **argv) {
+    ElogFlashIter iter;
+    static char buf[ELOG_FLASH_PAGE_SIZE];
+    size_t size;
+
+    if (argc > 1) {
+        if (!strcmp(argv[1], "read")) {
+            elog_flash_iter_init(&iter);
+            while ((size = elog_flash_iter_next(&iter, buf, sizeof(buf))) != 0) {
+                rt_kprintf("%.*s", size, buf);
+            }
+        } else if (!strcmp(argv[1], "flush")) {
+            elog_flash_flush();
+        } else if (!strcmp(argv[1], "clean")) {
+            elog_flash_clean();
+        } else {
+            rt_kprintf("Please input elog_flash read, flush or clean.\n");
+        }
+    } else {
+        rt_kprintf("Please input elog_flash read, flush or clean.\n");
+    }
+}
+MSH_CMD_EXPORT(elog_flash, EasyLogger flash log [read/flush/clean]);
+#endif
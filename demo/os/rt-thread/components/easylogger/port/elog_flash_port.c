@@ -0,0 +1,100 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Portable interface for flash log plugin on STM32F10x.
+ * Created on: 2026-10-19
+ */
+
+#include "elog_flash.h"
+#include <string.h>
+#include <stm32f10x_conf.h>
+
+/**
+ * read data from flash
+ *
+ * @param addr flash address
+ * @param buf buffer to store read data
+ * @param size read bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, void *buf, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    /* the flash is mapped to memory */
+    memcpy(buf, (void *) addr, size);
+
+    return result;
+}
+
+/**
+ * Erase flash. The start address and size are aligned by ELOG_FLASH_SECTOR_SIZE.
+ *
+ * @param addr flash address
+ * @param size erase bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    FLASH_Status flash_status;
+    size_t i;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+    for (i = 0; i < size; i += ELOG_FLASH_SECTOR_SIZE) {
+        flash_status = FLASH_ErasePage(addr + i);
+        if (flash_status != FLASH_COMPLETE) {
+            result = ELOG_FLASH_ERASE_ERR;
+            break;
+        }
+    }
+    FLASH_Lock();
+
+    return result;
+}
+
+/**
+ * Write data to flash. The start address and size are aligned by 4 bytes.
+ *
+ * @param addr flash address
+ * @param buf the write data buffer
+ * @param size write bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_write(uint32_t addr, const uint32_t *buf, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    size_t i;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+    for (i = 0; i < size; i += 4, buf++, addr += 4) {
+        /* the erased word needn't be written */
+        if (*buf == 0xFFFFFFFF) {
+            continue;
+        }
+        if (FLASH_ProgramWord(addr, *buf) != FLASH_COMPLETE || *(uint32_t *) addr != *buf) {
+            result = ELOG_FLASH_WRITE_ERR;
+            break;
+        }
+    }
+    FLASH_Lock();
+
+    return result;
+}
@@ -23,8 +23,20 @@
 #include "elog.h"
 #include <rthw.h>
 #include <rtthread.h>
+#include <usart.h>
+#ifdef ELOG_USING_OUTPUT_FLASH
+#include <elog_flash.h>
+#endif
+#ifdef ELOG_PORT_USING_CYCLE
+#include <stm32f10x.h>
+#endif
 
+#ifndef ELOG_USING_TICKET_LOCK
 static struct rt_semaphore output_lock;
+#endif
+#ifdef ELOG_USING_PERCPU
+static struct rt_semaphore cpu_lock;
+#endif
 
 /**
  * EasyLogger port initialize
@@ -34,7 +46,24 @@ static struct rt_semaphore output_lock;
 ElogErrCode elog_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
 
+#ifndef ELOG_USING_TICKET_LOCK
     rt_sem_init(&output_lock, "elog lock", 1, RT_IPC_FLAG_PRIO);
+#endif
+#ifdef ELOG_USING_PERCPU
+    rt_sem_init(&cpu_lock, "elog cpu", 1, RT_IPC_FLAG_PRIO);
+#endif
+
+#ifdef ELOG_PORT_USING_CYCLE
+    /* enable DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+#ifdef ELOG_USING_OUTPUT_FLASH
+    /* flash log plugin initialize. the output to flash will be disabled when it failed. */
+    elog_flash_init();
+#endif
 
     return result;
 }
@@ -43,11 +72,21 @@ ElogErrCode elog_port_init(void) {
  * output log port interface
  */
 void elog_port_output(const char *output, size_t size) {
+#ifdef RT_USING_UART1_DMA_TX
+    /* output to terminal by DMA, it will return immediately. the whole log is dropped and counted when the
+     * DMA buffer is full, the count can be got by rt_hw_usart1_dma_get_dropped */
+    rt_hw_usart1_dma_write(output, size);
+#else
     /* output to terminal */
     rt_kprintf("%.*s", size, output);
-    //TODO output to flash
+#endif
+#ifdef ELOG_USING_OUTPUT_FLASH
+    /* output to flash */
+    elog_flash_write(output, size);
+#endif
 }
 
+#ifndef ELOG_USING_TICKET_LOCK
 /**
  * output lock
  */
@@ -61,6 +100,15 @@ void elog_port_output_lock(void) {
 void elog_port_output_unlock(void) {
     rt_sem_release(&output_lock);
 }
+#else
+/**
+ * yield the CPU interface for built-in output lock. The lock holder maybe a lower priority thread,
+ * so the current thread sleeps a tick instead of rt_thread_yield.
+ */
+void elog_port_lock_yield(void) {
+    rt_thread_delay(1);
+}
+#endif /* ELOG_USING_TICKET_LOCK */
 
 /**
  * get current time interface
@@ -90,3 +138,114 @@ const char *elog_port_get_p_info(void) {
 const char *elog_port_get_t_info(void) {
     return rt_thread_self()->name;
 }
+
+/**
+ * get current system time in millisecond interface
+ *
+ * @return current millisecond
+ */
+uint32_t elog_port_get_ms(void) {
+    return (uint32_t) ((uint64_t) rt_tick_get() * 1000 / RT_TICK_PER_SECOND);
+}
+
+/**
+ * check current context is in ISR or not interface
+ *
+ * @return true: in ISR
+ */
+bool elog_port_in_isr(void) {
+    return rt_interrupt_get_nest() > 0;
+}
+
+/**
+ * disable interrupt interface
+ *
+ * @return the interrupt level before disabled
+ */
+uint32_t elog_port_irq_disable(void) {
+    return rt_hw_interrupt_disable();
+}
+
+/**
+ * enable interrupt interface
+ *
+ * @param level the interrupt level which is returned by elog_port_irq_disable
+ */
+void elog_port_irq_enable(uint32_t level) {
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * get output backlog interface, it's used by adaptive throttling
+ *
+ * @return the usage percent (0~100) of output buffer or queue, 0: the output isn't buffered
+ */
+uint8_t elog_port_get_backlog(void) {
+#ifdef RT_USING_UART1_DMA_TX
+    return rt_hw_usart1_dma_get_usage();
+#else
+    /* the terminal output is blocked until it's finished, so there is no backlog */
+    return 0;
+#endif
+}
+
+#ifdef ELOG_USING_PERCPU
+/**
+ * get current CPU index interface
+ *
+ * @return CPU index
+ */
+uint8_t elog_port_get_cpu(void) {
+    /* STM32F103 is single core */
+    return 0;
+}
+
+/**
+ * CPU buffer lock
+ *
+ * @param cpu CPU index
+ */
+void elog_port_cpu_lock(uint8_t cpu) {
+    rt_sem_take(&cpu_lock, RT_WAITING_FOREVER);
+}
+
+/**
+ * CPU buffer unlock
+ *
+ * @param cpu CPU index
+ */
+void elog_port_cpu_unlock(uint8_t cpu) {
+    rt_sem_release(&cpu_lock);
+}
+#endif /* ELOG_USING_PERCPU */
+
+#ifdef ELOG_PORT_USING_CYCLE
+/**
+ * get the raw cycle counter interface
+ *
+ * @return cycle count
+ */
+uint32_t elog_port_get_cycle(void) {
+    return DWT->CYCCNT;
+}
+#endif /* ELOG_PORT_USING_CYCLE */
+
+#ifdef ELOG_USING_SPAN
+/**
+ * get current thread's innermost span interface, it's saved in thread's user data
+ *
+ * @return span, NULL: there is no span in current thread
+ */
+ElogSpan_t elog_port_get_span(void) {
+    return (ElogSpan_t) rt_thread_self()->user_data;
+}
+
+/**
+ * set current thread's innermost span interface
+ *
+ * @param span span, NULL: there is no span in current thread
+ */
+void elog_port_set_span(ElogSpan_t span) {
+    rt_thread_self()->user_data = (rt_uint32_t) span;
+}
+#endif /* ELOG_USING_SPAN */
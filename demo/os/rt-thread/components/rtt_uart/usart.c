@@ -12,6 +12,7 @@
  * 2009-01-05     Bernard      the first version
  * 2010-03-29     Bernard      remove interrupt Tx and DMA Rx mode
  * 2013-05-13     aozima       update for kehong-lingtai.
+ * 2026-10-19     armink       add UART1 double buffer DMA transmit for EasyLogger.
  */
 
 #include "stm32f10x.h"
@@ -19,6 +20,7 @@
 
 #include "bsp.h"
 #include <rtdevice.h>
+#include <string.h>
 
 /* USART1 */
 #define UART1_GPIO_TX        GPIO_Pin_9
@@ -255,6 +257,145 @@ void USART1_IRQHandler(void)
 }
 #endif /* RT_USING_UART1 */
 
+#ifdef RT_USING_UART1_DMA_TX
+/* UART1 DMA transmit double buffer. One is filled by writer while the other is transmitted by DMA. */
+static rt_uint8_t uart1_dma_tx_buf[2][RT_UART1_DMA_TX_BUFFER_SIZE];
+static rt_size_t uart1_dma_tx_len[2];
+/* the buffer index which is filled by writer */
+static rt_uint8_t uart1_dma_tx_fill = 0;
+static rt_bool_t uart1_dma_tx_busy = RT_FALSE;
+/* the number of dropped records because the filling buffer has not enough space */
+static rt_uint32_t uart1_dma_tx_dropped = 0;
+
+/* transmit the filled buffer by DMA, and swap the buffers. the interrupt must be disabled. */
+static void uart1_dma_tx_start(void)
+{
+    rt_uint8_t index = uart1_dma_tx_fill;
+
+    uart1_dma_tx_fill ^= 1;
+    uart1_dma_tx_len[uart1_dma_tx_fill] = 0;
+
+    DMA_Cmd(DMA1_Channel4, DISABLE);
+    DMA1_Channel4->CMAR = (rt_uint32_t) uart1_dma_tx_buf[index];
+    DMA_SetCurrDataCounter(DMA1_Channel4, uart1_dma_tx_len[index]);
+    DMA_Cmd(DMA1_Channel4, ENABLE);
+    uart1_dma_tx_busy = RT_TRUE;
+}
+
+/**
+ * Write data to UART1 by DMA. It will return immediately. The data is written or dropped as a whole
+ * record, it will be dropped and counted when the filling buffer has not enough space.
+ *
+ * @param buffer data
+ * @param size data size
+ *
+ * @return the written size, 0: the data is dropped
+ */
+rt_size_t rt_hw_usart1_dma_write(const void *buffer, rt_size_t size)
+{
+    rt_base_t level;
+    rt_size_t space;
+
+    level = rt_hw_interrupt_disable();
+
+    space = RT_UART1_DMA_TX_BUFFER_SIZE - uart1_dma_tx_len[uart1_dma_tx_fill];
+    if (size > space)
+    {
+        /* the record isn't cut, or the next record will be glued onto the cut one */
+        uart1_dma_tx_dropped++;
+        rt_hw_interrupt_enable(level);
+        return 0;
+    }
+    memcpy(uart1_dma_tx_buf[uart1_dma_tx_fill] + uart1_dma_tx_len[uart1_dma_tx_fill], buffer, size);
+    uart1_dma_tx_len[uart1_dma_tx_fill] += size;
+    /* the DMA is idle, so start it now */
+    if (!uart1_dma_tx_busy && uart1_dma_tx_len[uart1_dma_tx_fill])
+    {
+        uart1_dma_tx_start();
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return size;
+}
+
+/**
+ * Get the usage of UART1 DMA filling buffer. It's high when the data is written faster than transmitted.
+ *
+ * @return usage percent
+ */
+rt_uint8_t rt_hw_usart1_dma_get_usage(void)
+{
+    return (rt_uint8_t) (uart1_dma_tx_len[uart1_dma_tx_fill] * 100 / RT_UART1_DMA_TX_BUFFER_SIZE);
+}
+
+/**
+ * Get the number of records which are dropped by UART1 DMA writing since startup.
+ *
+ * @return dropped record number
+ */
+rt_uint32_t rt_hw_usart1_dma_get_dropped(void)
+{
+    return uart1_dma_tx_dropped;
+}
+
+void DMA1_Channel4_IRQHandler(void)
+{
+    rt_base_t level;
+
+    /* enter interrupt */
+    rt_interrupt_enter();
+    if (DMA_GetITStatus(DMA1_IT_TC4) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC4);
+        level = rt_hw_interrupt_disable();
+        /* the other buffer has been filled during the transmission */
+        if (uart1_dma_tx_len[uart1_dma_tx_fill])
+        {
+            uart1_dma_tx_start();
+        }
+        else
+        {
+            uart1_dma_tx_busy = RT_FALSE;
+        }
+        rt_hw_interrupt_enable(level);
+    }
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+static void DMA_Configuration(void)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    /* USART1 TX is on DMA1 channel 4 */
+    DMA_DeInit(DMA1_Channel4);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (rt_uint32_t) &USART1->DR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (rt_uint32_t) uart1_dma_tx_buf[0];
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_BufferSize = RT_UART1_DMA_TX_BUFFER_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel4, &DMA_InitStructure);
+    DMA_ITConfig(DMA1_Channel4, DMA_IT_TC, ENABLE);
+    USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE);
+
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel4_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+#endif /* RT_USING_UART1_DMA_TX */
+
 #if defined(RT_USING_UART2)
 /* UART1 device driver structure */
 struct stm32_uart uart2 =
@@ -451,6 +592,10 @@ void rt_hw_usart_init(void)
     rt_hw_serial_register(&serial1, "uart1",
                           RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX ,
                           uart);
+
+#ifdef RT_USING_UART1_DMA_TX
+    DMA_Configuration();
+#endif
 #endif /* RT_USING_UART1 */
 
 #ifdef RT_USING_UART2
@@ -22,5 +22,10 @@
 #define UART_DISABLE_IRQ(n)           NVIC_DisableIRQ((n))
 
 void rt_hw_usart_init(void);
+#ifdef RT_USING_UART1_DMA_TX
+rt_size_t rt_hw_usart1_dma_write(const void *buffer, rt_size_t size);
+rt_uint8_t rt_hw_usart1_dma_get_usage(void);
+rt_uint32_t rt_hw_usart1_dma_get_dropped(void);
+#endif
 
 #endif
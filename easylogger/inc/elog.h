@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdarg.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,8 +43,10 @@ extern "C" {
 #define ELOG_OUTPUT_LVL                      ELOG_LVL_VERBOSE
 /* enable log output. default open this macro */
 #define ELOG_OUTPUT_ENABLE
-/* using output to file mode */
+/* using output to file mode, the file plugin (plugins/file) can be used on Linux */
 #define ELOG_USING_OUTPUT_FILE
+/* using output to flash mode, the flash plugin (plugins/flash) must be added to project */
+//#define ELOG_USING_OUTPUT_FLASH
 /* output line number max length */
 #define ELOG_LINE_NUM_MAX_LEN                5
 /* log buffer size */
@@ -52,8 +55,164 @@ extern "C" {
 #define ELOG_FILTER_TAG_MAX_LEN              16
 /* output filter's keyword max length */
 #define ELOG_FILTER_KW_MAX_LEN               16
+/* the file name which is output by ELOG_FMT_DIR, it can be defined by build system, such as relative path */
+#ifndef ELOG_FILE
+#if defined(__FILE_NAME__)
+/* GCC 12+ and Clang 9+, the file name without directory */
+#define ELOG_FILE                            __FILE_NAME__
+#elif defined(__CC_ARM)
+/* Keil MDK (armcc), the file name without directory */
+#define ELOG_FILE                            __MODULE__
+#else
+/* IAR can remove the directory by compiler option --no_path_in_file_macros */
+#define ELOG_FILE                            __FILE__
+#endif
+#endif /* ELOG_FILE */
+/* enable log rate limit for each call site. it will protect the output from log storm */
+//#define ELOG_USING_RATE_LIMIT
+#ifdef ELOG_USING_RATE_LIMIT
+/* max call site number which can be limited at the same time, the least recently used one is evicted when it's full */
+#define ELOG_RATE_LIMIT_SITE_MAX             16
+/* default max burst log number of each call site */
+#define ELOG_RATE_LIMIT_BURST                10
+/* default log number per second of each call site after the burst is used up, it must be greater than 0 */
+#define ELOG_RATE_LIMIT_RATE                 5
+#endif /* ELOG_USING_RATE_LIMIT */
+/* enable repeated log coalescing. the repeated log will be output as "last message repeated N times" */
+//#define ELOG_USING_COALESCE
+#ifdef ELOG_USING_COALESCE
+/* the repeated log counter will be flushed after this timeout (ms) */
+#define ELOG_COALESCE_TIMEOUT                5000
+#endif /* ELOG_USING_COALESCE */
+/* enable log sampling. only 1 in N logs or 1 log in a period is output for a tag or a call site */
+//#define ELOG_USING_SAMPLE
+#ifdef ELOG_USING_SAMPLE
+/* max sampling rule number */
+#define ELOG_SAMPLE_RULE_MAX                 8
+#endif /* ELOG_USING_SAMPLE */
+/* enable adaptive throttling. the low level logs are dropped when the output backlog is high */
+//#define ELOG_USING_THROTTLE
+#ifdef ELOG_USING_THROTTLE
+/* the level will be limited one step when the output backlog (percent) is higher than or equal to it */
+#define ELOG_THROTTLE_HIGH_WATERMARK         75
+/* the level will be restored one step when the output backlog (percent) is lower than or equal to it */
+#define ELOG_THROTTLE_LOW_WATERMARK          25
+/* the lowest level which the output can be limited to */
+#define ELOG_THROTTLE_MIN_LVL                ELOG_LVL_INFO
+/* min interval (ms) between two level transitions */
+#define ELOG_THROTTLE_INTERVAL               100
+#endif /* ELOG_USING_THROTTLE */
+/* enable flight recorder. all logs are recorded to RAM, only the high level logs are output */
+//#define ELOG_USING_FLIGHT_RECORDER
+#ifdef ELOG_USING_FLIGHT_RECORDER
+/* flight recorder buffer size */
+#define ELOG_FLIGHT_BUF_SIZE                 4096
+/* the log which level is higher than or equal to this level will be output */
+#define ELOG_FLIGHT_OUTPUT_LVL               ELOG_LVL_WARN
+/* the flight recorder will be dumped automatically when this level log is output */
+#define ELOG_FLIGHT_DUMP_LVL                 ELOG_LVL_ASSERT
+#endif /* ELOG_USING_FLIGHT_RECORDER */
+/* enable crash log. the newest logs will be kept in no-init RAM, and be replayed after warm reset */
+//#define ELOG_USING_CRASH_LOG
+#ifdef ELOG_USING_CRASH_LOG
+/* crash log buffer size */
+#define ELOG_CRASH_LOG_BUF_SIZE              1024
+/* the attribute which places crash log to no-init section. Keil MDK must set the section to UNINIT in scatter file */
+#if defined(__ICCARM__)
+#define ELOG_CRASH_LOG_ATTR                  __no_init
+#elif defined(__CC_ARM)
+#define ELOG_CRASH_LOG_ATTR                  __attribute__((section(".bss.NoInit"), zero_init))
+#else
+#define ELOG_CRASH_LOG_ATTR                  __attribute__((section(".noinit")))
+#endif
+#endif /* ELOG_USING_CRASH_LOG */
+/* enable ISR log. the log in ISR will be saved to buffer without lock, and be output in thread context */
+//#define ELOG_USING_ISR
+#ifdef ELOG_USING_ISR
+/* max ISR log number in assert and error lane buffer */
+#define ELOG_ISR_BUF_FAULT_NUM               4
+/* max ISR log number in warn and info lane buffer, and in debug and verbose lane buffer */
+#define ELOG_ISR_BUF_NUM                     8
+/* ISR log's max length without header info */
+#define ELOG_ISR_LOG_MAX_LEN                 64
+#endif /* ELOG_USING_ISR */
+/* enable per-CPU log buffer. the log is saved to current CPU's buffer without output lock, and the logs
+ * of all CPUs are merged by time and output by elog_flush */
+//#define ELOG_USING_PERCPU
+#ifdef ELOG_USING_PERCPU
+/* max CPU number */
+#define ELOG_PERCPU_CPU_NUM                  4
+/* max log number in each CPU's buffer */
+#define ELOG_PERCPU_BUF_NUM                  32
+/* max log length in CPU's buffer include header info */
+#define ELOG_PERCPU_LOG_MAX_LEN              128
+#endif /* ELOG_USING_PERCPU */
+/* enable cycle counter timestamp. the raw cycle count is taken at call time and output by ELOG_FMT_CYCLE,
+ * it's converted to time by tools/elog_cycle.py with the calibration points */
+//#define ELOG_USING_CYCLE
+#ifdef ELOG_USING_CYCLE
+/* calibration point output interval (ms), it must be less than the cycle counter overflow period */
+#define ELOG_CYCLE_CALIB_INTERVAL            1000
+#endif /* ELOG_USING_CYCLE */
+/* enable self-latency histogram. the latency (cycles) of log API and elog_port_output is measured by
+ * elog_port_get_cycle, and it's counted to log-linear histogram which can be got by elog_latency_get_xxx */
+//#define ELOG_USING_LATENCY
+#ifdef ELOG_USING_LATENCY
+/* each power of two range is split to (1 << ELOG_LATENCY_SUB_BITS) buckets, it's the relative error */
+#define ELOG_LATENCY_SUB_BITS                2
+/* power of two range number, the latency which is greater than 2^(GROUP_NUM + SUB_BITS - 1) is in last bucket */
+#define ELOG_LATENCY_GROUP_NUM               20
+#endif /* ELOG_USING_LATENCY */
+/* enable timing span. ELOG_SPAN_BEGIN/ELOG_SPAN_END (or scoped ELOG_SPAN) measure the cycles of the code region,
+ * the span is filtered by level and tag, and the nested span is indented by it's depth */
+//#define ELOG_USING_SPAN
+#ifdef ELOG_USING_SPAN
+/* output the span as compact record "[elog span] ..." instead of log line, it can be converted by tools/elog_trace.py */
+//#define ELOG_SPAN_USING_RECORD
+#endif /* ELOG_USING_SPAN */
+/* enable tag table. the tag is interned to numeric ID, and each tag can has it's own output level */
+//#define ELOG_USING_TAG_TABLE
+#ifdef ELOG_USING_TAG_TABLE
+/* max tag number in tag table, it must be less than 255 */
+#define ELOG_TAG_MAX_NUM                     32
+#endif /* ELOG_USING_TAG_TABLE */
+/* enable dictionary log. elog_id_a ~ elog_id_v only output ID and arguments, see tools/elog_dict.py */
+//#define ELOG_USING_DICT
+#ifdef ELOG_USING_DICT
+/* max argument number of dictionary log, it can't be greater than 8 */
+#define ELOG_DICT_ARGS_MAX                   8
+#endif /* ELOG_USING_DICT */
+/* enable built-in output lock. it's a ticket lock by C11 atomics, elog_port_output_lock and elog_port_output_unlock
+ * are provided by EasyLogger, the port only implements elog_port_lock_yield. it's suitable for the short critical
+ * section which shouldn't pay for the kernel IPC object */
+//#define ELOG_USING_TICKET_LOCK
+#ifdef ELOG_USING_TICKET_LOCK
+/* backoff spin number for each lock waiter before current one */
+#define ELOG_TICKET_LOCK_BACKOFF             32
+/* max spin number of the lock waiter, then it yields the CPU by elog_port_lock_yield, because the lock holder
+ * maybe preempted. it should be 0 on single core, the holder can't run when the waiter is spinning */
+#define ELOG_TICKET_LOCK_SPIN_MAX            1024
+#endif /* ELOG_USING_TICKET_LOCK */
 /* EasyLogger software version number */
 #define ELOG_SW_VERSION                      "0.05.25"
+/* initial value for elog_hash() */
+#define ELOG_HASH_INIT                       2166136261UL
+
+/* the tag's output level is not set, the global filter level will be used */
+#define ELOG_TAG_LVL_DEFAULT                 0xFF
+/* the invalid tag ID */
+#define ELOG_TAG_ID_INVALID                  0xFF
+/* the port should implement elog_port_get_cycle when these features are enabled */
+#if defined(ELOG_USING_CYCLE) || defined(ELOG_USING_LATENCY) || defined(ELOG_USING_SPAN)
+#define ELOG_PORT_USING_CYCLE
+#endif
+/* the port should implement elog_port_irq_disable and elog_port_irq_enable when these features are enabled */
+#if defined(ELOG_USING_ISR) || defined(ELOG_USING_PERCPU) || defined(ELOG_USING_LATENCY)
+#define ELOG_PORT_USING_IRQ
+#endif
+/* ISR log lane number, and the lane of the level: 0: assert and error, 1: warn and info, 2: debug and verbose */
+#define ELOG_ISR_LANE_NUM                    3
+#define ELOG_ISR_LANE(level)                 ((level) / 2)
 
 /* EasyLogger assert for developer. */
 #define ELOG_ASSERT(EXPR)                                                   \
@@ -73,8 +232,95 @@ typedef enum {
     ELOG_FMT_DIR    = 1 << 5, /**< file directory and name */
     ELOG_FMT_FUNC   = 1 << 6, /**< function name */
     ELOG_FMT_LINE   = 1 << 7, /**< line number */
+    ELOG_FMT_SEQ    = 1 << 8, /**< global sequence number */
+    ELOG_FMT_CYCLE  = 1 << 9, /**< cycle count at call time, it needs ELOG_USING_CYCLE */
 } ElogFmtIndex;
 
+/* log ring buffer */
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t write_pos;
+    bool full;
+} ElogRing, *ElogRing_t;
+
+/* output log's filter */
+typedef struct {
+    uint8_t level;
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
+    char keyword[ELOG_FILTER_KW_MAX_LEN + 1];
+} ElogFilter, *ElogFilter_t;
+
+/* logger. each logger has it's own filter, format, buffer, lock and output */
+typedef struct {
+    ElogFilter filter;
+    size_t enabled_fmt_set;
+    bool output_enabled;
+    /* log buffer */
+    char *buf;
+    size_t buf_size;
+    /* output, lock and unlock function. the lock and unlock can be NULL when it's used by only one thread */
+    void (*output)(const char *log, size_t size);
+    void (*lock)(void);
+    void (*unlock)(void);
+} ElogLogger, *ElogLogger_t;
+
+/* timing span, it's saved in caller's stack */
+typedef struct _ElogSpan {
+    const char *name;
+    const char *tag;
+    const uint32_t *tag_hash;
+    const char *file;
+    const char *func;
+    long line;
+    uint8_t level;
+    /* the nesting depth, 0: top span of the thread */
+    uint8_t depth;
+    /* the span is filtered when it's false, then it won't be measured and output */
+    bool enabled;
+    /* the cycle count at begin */
+    uint32_t start;
+    /* the outer span in the same thread */
+    struct _ElogSpan *parent;
+} ElogSpan, *ElogSpan_t;
+
+#ifdef ELOG_USING_ISR
+/* the log which is output in ISR */
+typedef struct {
+    volatile bool ready;
+    uint8_t level;
+    const char *tag;
+    const char *file;
+    const char *func;
+    long line;
+    uint32_t ms;
+    char log[ELOG_ISR_LOG_MAX_LEN];
+} ElogIsrLog, *ElogIsrLog_t;
+#endif
+
+#ifdef ELOG_USING_PERCPU
+/* the log in per-CPU buffer */
+typedef struct {
+    uint8_t level;
+    const char *file;
+    long line;
+    /* the global sequence number, the logs are merged by it */
+    uint64_t seq;
+    size_t head_len;
+    size_t len;
+    char log[ELOG_PERCPU_LOG_MAX_LEN];
+} ElogCpuLog, *ElogCpuLog_t;
+#endif
+
+#ifdef ELOG_USING_LATENCY
+/* the measured latency type */
+typedef enum {
+    ELOG_LATENCY_CALL,                  /**< log API call, from entry to return */
+    ELOG_LATENCY_OUTPUT,                /**< elog_port_output */
+    ELOG_LATENCY_TYPE_NUM,
+} ElogLatencyType;
+#endif
+
 /* EasyLogger error code */
 typedef enum {
     ELOG_NO_ERR,
@@ -87,11 +333,36 @@ bool elog_get_output_enabled(void);
 void elog_set_fmt(size_t set);
 void elog_set_filter(uint8_t level, const char *tag, const char *keyword);
 void elog_set_filter_lvl(uint8_t level);
+uint8_t elog_get_filter_lvl(void);
 void elog_set_filter_tag(const char *tag);
 void elog_set_filter_kw(const char *keyword);
 void elog_raw(const char *format, ...);
+void elog_flush(void);
+void elog_set_flush_hook(void (*hook)(void));
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...);
+void elog_isr_output(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...);
+void elog_output_hash(uint8_t level, const char *tag, uint32_t tag_hash, const char *file,
+        const char *func, const long line, const char *format, ...);
+void elog_isr_output_hash(uint8_t level, const char *tag, uint32_t tag_hash, const char *file,
+        const char *func, const long line, const char *format, ...);
+void elog_output_str(uint8_t level, const char *tag, const uint32_t *tag_hash, const char *file,
+        const char *func, const long line, const char *str);
+bool elog_output_check(uint8_t level, const char *tag, const uint32_t *tag_hash);
+ElogLogger_t elog_get_logger(void);
+void elog_logger_init(ElogLogger_t logger, char *buf, size_t size, void (*output)(const char *log, size_t size),
+        void (*lock)(void), void (*unlock)(void));
+void elog_logger_set_output_enabled(ElogLogger_t logger, bool enabled);
+bool elog_logger_get_output_enabled(ElogLogger_t logger);
+void elog_logger_set_fmt(ElogLogger_t logger, size_t set);
+void elog_logger_set_filter(ElogLogger_t logger, uint8_t level, const char *tag, const char *keyword);
+void elog_logger_set_filter_lvl(ElogLogger_t logger, uint8_t level);
+uint8_t elog_logger_get_filter_lvl(ElogLogger_t logger);
+void elog_logger_set_filter_tag(ElogLogger_t logger, const char *tag);
+void elog_logger_set_filter_kw(ElogLogger_t logger, const char *keyword);
+void elog_logger_output(ElogLogger_t logger, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...);
 
 #ifndef ELOG_OUTPUT_ENABLE
 
@@ -106,48 +377,346 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
 
 #if ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT
 #define elog_a(tag, ...) \
-        elog_output(ELOG_LVL_ASSERT, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+        elog_output(ELOG_LVL_ASSERT, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
 #else
 #define elog_a(tag, ...)
 #endif
 
 #if ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR
 #define elog_e(tag, ...) \
-        elog_output(ELOG_LVL_ERROR, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+        elog_output(ELOG_LVL_ERROR, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
 #else
 #define elog_e(tag, ...)
 #endif
 
 #if ELOG_OUTPUT_LVL >= ELOG_LVL_WARN
 #define elog_w(tag, ...) \
-        elog_output(ELOG_LVL_WARN, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+        elog_output(ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
 #else
 #define elog_w(tag, ...)
 #endif
 
 #if ELOG_OUTPUT_LVL >= ELOG_LVL_INFO
 #define elog_i(tag, ...) \
-        elog_output(ELOG_LVL_INFO, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+        elog_output(ELOG_LVL_INFO, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
 #else
 #define elog_i(tag, ...)
 #endif
 
 #if ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG
 #define elog_d(tag, ...) \
-        elog_output(ELOG_LVL_DEBUG, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+        elog_output(ELOG_LVL_DEBUG, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
 #else
 #define elog_d(tag, ...)
 #endif
 
 #if ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE
 #define elog_v(tag, ...) \
-        elog_output(ELOG_LVL_VERBOSE, tag, __FILE__, __FUNCTION__, __LINE__, __VA_ARGS__)
+        elog_output(ELOG_LVL_VERBOSE, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
 #endif
 
 #endif /* ELOG_OUTPUT_ENABLE */
 
+/* the log output API in ISR */
+#if !defined(ELOG_OUTPUT_ENABLE) || !defined(ELOG_USING_ISR)
+
+#define elog_isr_a(tag, ...)
+#define elog_isr_e(tag, ...)
+#define elog_isr_w(tag, ...)
+#define elog_isr_i(tag, ...)
+#define elog_isr_d(tag, ...)
+#define elog_isr_v(tag, ...)
+
+#else /* !defined(ELOG_OUTPUT_ENABLE) || !defined(ELOG_USING_ISR) */
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT
+#define elog_isr_a(tag, ...) \
+        elog_isr_output(ELOG_LVL_ASSERT, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_isr_a(tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR
+#define elog_isr_e(tag, ...) \
+        elog_isr_output(ELOG_LVL_ERROR, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_isr_e(tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_WARN
+#define elog_isr_w(tag, ...) \
+        elog_isr_output(ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_isr_w(tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_INFO
+#define elog_isr_i(tag, ...) \
+        elog_isr_output(ELOG_LVL_INFO, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_isr_i(tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG
+#define elog_isr_d(tag, ...) \
+        elog_isr_output(ELOG_LVL_DEBUG, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_isr_d(tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE
+#define elog_isr_v(tag, ...) \
+        elog_isr_output(ELOG_LVL_VERBOSE, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_isr_v(tag, ...)
+#endif
+
+#endif /* !defined(ELOG_OUTPUT_ENABLE) || !defined(ELOG_USING_ISR) */
+
+/* the log output API for logger which is initialized by elog_logger_init */
+#ifndef ELOG_OUTPUT_ENABLE
+
+#define elog_logger_a(logger, tag, ...)
+#define elog_logger_e(logger, tag, ...)
+#define elog_logger_w(logger, tag, ...)
+#define elog_logger_i(logger, tag, ...)
+#define elog_logger_d(logger, tag, ...)
+#define elog_logger_v(logger, tag, ...)
+
+#else /* ELOG_OUTPUT_ENABLE */
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT
+#define elog_logger_a(logger, tag, ...) \
+        elog_logger_output(logger, ELOG_LVL_ASSERT, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_logger_a(logger, tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR
+#define elog_logger_e(logger, tag, ...) \
+        elog_logger_output(logger, ELOG_LVL_ERROR, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_logger_e(logger, tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_WARN
+#define elog_logger_w(logger, tag, ...) \
+        elog_logger_output(logger, ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_logger_w(logger, tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_INFO
+#define elog_logger_i(logger, tag, ...) \
+        elog_logger_output(logger, ELOG_LVL_INFO, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_logger_i(logger, tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG
+#define elog_logger_d(logger, tag, ...) \
+        elog_logger_output(logger, ELOG_LVL_DEBUG, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_logger_d(logger, tag, ...)
+#endif
+
+#if ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE
+#define elog_logger_v(logger, tag, ...) \
+        elog_logger_output(logger, ELOG_LVL_VERBOSE, tag, ELOG_FILE, __FUNCTION__, __LINE__, __VA_ARGS__)
+#else
+#define elog_logger_v(logger, tag, ...)
+#endif
+
+#endif /* ELOG_OUTPUT_ENABLE */
+
+/* the dictionary log API. the ID is assigned by tools/elog_dict.py, the arguments must be integer */
+#if !defined(ELOG_OUTPUT_ENABLE)
+
+#define elog_id_a(id, tag, ...)
+#define elog_id_e(id, tag, ...)
+#define elog_id_w(id, tag, ...)
+#define elog_id_i(id, tag, ...)
+#define elog_id_d(id, tag, ...)
+#define elog_id_v(id, tag, ...)
+#define elog_id_float(value)                 (value)
+
+#elif !defined(ELOG_USING_DICT)
+
+/* it's same as the normal log API when the dictionary log is disabled */
+#define elog_id_a(id, tag, ...)              elog_a(tag, __VA_ARGS__)
+#define elog_id_e(id, tag, ...)              elog_e(tag, __VA_ARGS__)
+#define elog_id_w(id, tag, ...)              elog_w(tag, __VA_ARGS__)
+#define elog_id_i(id, tag, ...)              elog_i(tag, __VA_ARGS__)
+#define elog_id_d(id, tag, ...)              elog_d(tag, __VA_ARGS__)
+#define elog_id_v(id, tag, ...)              elog_v(tag, __VA_ARGS__)
+#define elog_id_float(value)                 ((double) (value))
+
+#else /* ELOG_USING_DICT */
+
+/* the tag and format aren't used, so they won't be saved in firmware */
+#define elog_id_a(id, tag, ...)              ELOG_DICT_OUTPUT(ELOG_LVL_ASSERT, id, __VA_ARGS__)
+#define elog_id_e(id, tag, ...)              ELOG_DICT_OUTPUT(ELOG_LVL_ERROR, id, __VA_ARGS__)
+#define elog_id_w(id, tag, ...)              ELOG_DICT_OUTPUT(ELOG_LVL_WARN, id, __VA_ARGS__)
+#define elog_id_i(id, tag, ...)              ELOG_DICT_OUTPUT(ELOG_LVL_INFO, id, __VA_ARGS__)
+#define elog_id_d(id, tag, ...)              ELOG_DICT_OUTPUT(ELOG_LVL_DEBUG, id, __VA_ARGS__)
+#define elog_id_v(id, tag, ...)              ELOG_DICT_OUTPUT(ELOG_LVL_VERBOSE, id, __VA_ARGS__)
+/* the floating point argument must be converted by it, otherwise it will be truncated to integer */
+#define elog_id_float(value)                 elog_dict_float(value)
+
+#define ELOG_DICT_OUTPUT(level, id, ...)                                    \
+do {                                                                        \
+    if (level <= ELOG_OUTPUT_LVL) {                                         \
+        elog_dict_output(level, id, ELOG_DICT_ARGS(__VA_ARGS__));           \
+    }                                                                       \
+} while (0)
+
+/* convert "format, arg1, ... argN" to "N, (uint32_t)(arg1), ... (uint32_t)(argN)" */
+#define ELOG_DICT_ARGS(...)                  ELOG_DICT_CAT(ELOG_DICT_ARGS_, ELOG_DICT_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define ELOG_DICT_NARGS(...)                 ELOG_DICT_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define ELOG_DICT_NARGS_(f, a1, a2, a3, a4, a5, a6, a7, a8, n, ...) n
+#define ELOG_DICT_CAT(a, b)                  ELOG_DICT_CAT_(a, b)
+#define ELOG_DICT_CAT_(a, b)                 a##b
+#define ELOG_DICT_ARG(a)                     (uint32_t)(a)
+#define ELOG_DICT_ARGS_0(f)                  0
+#define ELOG_DICT_ARGS_1(f, a1)              1, ELOG_DICT_ARG(a1)
+#define ELOG_DICT_ARGS_2(f, a1, a2)          2, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2)
+#define ELOG_DICT_ARGS_3(f, a1, a2, a3)      3, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2), ELOG_DICT_ARG(a3)
+#define ELOG_DICT_ARGS_4(f, a1, a2, a3, a4)  4, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2), ELOG_DICT_ARG(a3), \
+        ELOG_DICT_ARG(a4)
+#define ELOG_DICT_ARGS_5(f, a1, a2, a3, a4, a5) 5, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2), ELOG_DICT_ARG(a3), \
+        ELOG_DICT_ARG(a4), ELOG_DICT_ARG(a5)
+#define ELOG_DICT_ARGS_6(f, a1, a2, a3, a4, a5, a6) 6, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2), ELOG_DICT_ARG(a3), \
+        ELOG_DICT_ARG(a4), ELOG_DICT_ARG(a5), ELOG_DICT_ARG(a6)
+#define ELOG_DICT_ARGS_7(f, a1, a2, a3, a4, a5, a6, a7) 7, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2), \
+        ELOG_DICT_ARG(a3), ELOG_DICT_ARG(a4), ELOG_DICT_ARG(a5), ELOG_DICT_ARG(a6), ELOG_DICT_ARG(a7)
+#define ELOG_DICT_ARGS_8(f, a1, a2, a3, a4, a5, a6, a7, a8) 8, ELOG_DICT_ARG(a1), ELOG_DICT_ARG(a2), \
+        ELOG_DICT_ARG(a3), ELOG_DICT_ARG(a4), ELOG_DICT_ARG(a5), ELOG_DICT_ARG(a6), ELOG_DICT_ARG(a7), \
+        ELOG_DICT_ARG(a8)
+
+#endif /* !defined(ELOG_OUTPUT_ENABLE) */
+
+/* the timing span API */
+#if !defined(ELOG_OUTPUT_ENABLE) || !defined(ELOG_USING_SPAN)
+
+#define ELOG_SPAN_BEGIN(span, level, tag, name)
+#define ELOG_SPAN_END(span)
+#define ELOG_SPAN(level, tag, name)
+
+#else /* !defined(ELOG_OUTPUT_ENABLE) || !defined(ELOG_USING_SPAN) */
+
+/* the span which level is higher than ELOG_OUTPUT_LVL is removed by compiler, span is the variable name */
+#define ELOG_SPAN_BEGIN(span, level, tag, name) \
+        ElogSpan span; \
+        if ((level) <= ELOG_OUTPUT_LVL) { \
+            elog_span_begin(&span, level, tag, NULL, name, ELOG_FILE, __FUNCTION__, __LINE__); \
+        } else { \
+            span.enabled = false; \
+        }
+#define ELOG_SPAN_END(span) \
+        if (span.enabled) { \
+            elog_span_end(&span); \
+        }
+
+/* the span variable name of ELOG_SPAN */
+#define ELOG_SPAN_VAR_(line)                 elog_span_##line
+#define ELOG_SPAN_VAR(line)                  ELOG_SPAN_VAR_(line)
+
+/* the span which ends automatically when it's out of scope, it needs cleanup attribute of GCC and Clang.
+ * the C++ version is in elog.hpp */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__CC_ARM) && !defined(__cplusplus)
+#define ELOG_SPAN(level, tag, name) \
+        ElogSpan ELOG_SPAN_VAR(__LINE__) __attribute__((cleanup(elog_span_cleanup))); \
+        if ((level) <= ELOG_OUTPUT_LVL) { \
+            elog_span_begin(&ELOG_SPAN_VAR(__LINE__), level, tag, NULL, name, ELOG_FILE, __FUNCTION__, __LINE__); \
+        } else { \
+            ELOG_SPAN_VAR(__LINE__).enabled = false; \
+        }
+#endif
+
+#endif /* !defined(ELOG_OUTPUT_ENABLE) || !defined(ELOG_USING_SPAN) */
+
 /* elog_utils.c */
 size_t elog_strcpy(size_t cur_len, char *dst, const char *src);
+uint32_t elog_hash(uint32_t hash, const void *data, size_t size);
+uint64_t elog_seq_next(void);
+void elog_ring_write(ElogRing_t ring, const char *data, size_t size);
+void elog_ring_output(ElogRing_t ring, size_t size);
+
+/* elog_rate.c */
+void elog_set_rate_limit(uint8_t level, uint16_t burst, uint16_t rate);
+bool elog_rate_limit_check(uint8_t level, const char *file, long line, size_t *suppressed);
+size_t elog_rate_limit_get_evicted(const char **file, long *line);
+
+/* elog_sample.c */
+bool elog_set_sample(const char *tag, const char *file, long line, uint32_t rate, uint32_t period);
+bool elog_sample_check(const char *tag, const char *file, long line, uint32_t *sample);
+
+/* elog_throttle.c */
+bool elog_throttle_update(size_t *dropped);
+bool elog_throttle_check(uint8_t level);
+uint8_t elog_throttle_get_lvl(void);
+
+/* elog_coalesce.c */
+bool elog_coalesce_check(const char *file, long line, const char *log, size_t size);
+void elog_coalesce_flush(void);
+
+/* elog_flight.c */
+void elog_flight_write(const char *log, size_t size);
+void elog_flight_output(size_t size);
+void elog_flight_dump(size_t size);
+
+/* elog_crash.c */
+bool elog_crash_log_init(void);
+void elog_crash_log_write(const char *log, size_t size);
+
+/* elog_isr.c */
+#ifdef ELOG_USING_ISR
+void elog_isr_write(uint8_t level, const char *tag, const char *file, const char *func, long line,
+        const char *format, va_list args);
+ElogIsrLog_t elog_isr_read(void);
+void elog_isr_release(void);
+size_t elog_isr_get_dropped(size_t lane);
+#endif
+
+/* elog_percpu.c */
+#ifdef ELOG_USING_PERCPU
+ElogCpuLog_t elog_percpu_alloc(uint8_t cpu);
+void elog_percpu_commit(uint8_t cpu);
+void elog_percpu_begin(void);
+ElogCpuLog_t elog_percpu_read(void);
+void elog_percpu_release(void);
+void elog_percpu_end(void);
+size_t elog_percpu_get_dropped(uint8_t cpu);
+#endif
+
+/* elog_latency.c */
+#ifdef ELOG_USING_LATENCY
+void elog_latency_record(ElogLatencyType type, uint32_t cycles);
+uint32_t elog_latency_get_count(ElogLatencyType type);
+uint32_t elog_latency_get_max(ElogLatencyType type);
+uint32_t elog_latency_get_percentile(ElogLatencyType type, uint16_t permille);
+uint32_t elog_latency_bucket_min(size_t index);
+void elog_latency_clean(void);
+void elog_latency_dump(void);
+#endif
+
+/* elog_span.c */
+void elog_span_begin(ElogSpan_t span, uint8_t level, const char *tag, const uint32_t *tag_hash, const char *name,
+        const char *file, const char *func, long line);
+void elog_span_end(ElogSpan_t span);
+void elog_span_cleanup(ElogSpan_t span);
+
+/* elog_tag.c */
+uint8_t elog_tag_get_id(const char *tag, const uint32_t *tag_hash);
+uint8_t elog_tag_find_id(const char *tag, const uint32_t *tag_hash);
+bool elog_tag_check(uint8_t id, uint8_t level, uint8_t default_lvl, const char *filter_tag);
+void elog_tag_filter_changed(void);
+bool elog_set_tag_lvl(const char *tag, uint8_t level);
+uint8_t elog_get_tag_lvl(const char *tag);
+
+/* elog_dict.c */
+void elog_dict_output(uint8_t level, uint32_t id, size_t argc, ...);
+uint32_t elog_dict_float(float value);
 
 /* elog_port.c */
 ElogErrCode elog_port_init(void);
@@ -157,6 +726,18 @@ void elog_port_output_unlock(void);
 const char *elog_port_get_time(void);
 const char *elog_port_get_p_info(void);
 const char *elog_port_get_t_info(void);
+uint32_t elog_port_get_ms(void);
+bool elog_port_in_isr(void);
+uint32_t elog_port_irq_disable(void);
+void elog_port_irq_enable(uint32_t level);
+uint8_t elog_port_get_backlog(void);
+uint8_t elog_port_get_cpu(void);
+void elog_port_cpu_lock(uint8_t cpu);
+void elog_port_cpu_unlock(uint8_t cpu);
+uint32_t elog_port_get_cycle(void);
+ElogSpan_t elog_port_get_span(void);
+void elog_port_set_span(ElogSpan_t span);
+void elog_port_lock_yield(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,508 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: It is an head file for C++ (C++11 or later). The tag is hashed at compile time.
+ * Created on: 2026-10-19
+ *
+ * Usage:
+ *
+ *     static constexpr elog::Tag TAG("wifi");
+ *     elog_i(TAG, "connected %d", id);
+ *     elog_i(ELOG_TAG("wifi"), "connected %d", id);
+ *
+ * The elog_a ~ elog_v macros are same as C. When the tag is a elog::Tag, the log is output by
+ * elog_output_hash(), so the C and C++ logs are still in one log stream, and the tag table
+ * (ELOG_USING_TAG_TABLE) needn't hash the tag string at runtime.
+ *
+ * The type safe API (C++20 or later) uses "{}" as placeholder, "{:x}" for hex integer and
+ * "{:.N}" for floating point precision, "{{" and "}}" for brace:
+ *
+ *     elog::i(TAG, "x={} y={:x} t={:.2}", x, y, 36.5);
+ *
+ * The format string is parsed at compile time by consteval constructor, the placeholder number
+ * must be same as the argument number, otherwise it's a compile error. Each argument is formatted
+ * by it's type, and the text is output by elog_output_str() without vsnprintf, so there is no
+ * runtime format parsing. The log which level is higher than ELOG_OUTPUT_LVL is removed at
+ * compile time.
+ */
+
+#ifndef __ELOG_HPP__
+#define __ELOG_HPP__
+
+#include "elog.h"
+
+#if __cplusplus >= 202002L
+#include <type_traits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#endif
+
+namespace elog {
+
+/**
+ * calculate the FNV-1a hash value at compile time, it's same as elog_hash(ELOG_HASH_INIT, str, strlen(str))
+ *
+ * @param str string
+ * @param hash initial hash value
+ *
+ * @return hash value
+ */
+constexpr uint32_t hash(const char *str, uint32_t hash = ELOG_HASH_INIT) {
+    return *str ? elog::hash(str + 1, static_cast<uint32_t>((hash ^ static_cast<uint8_t>(*str)) * 16777619UL)) : hash;
+}
+
+/* force the hash value to be calculated at compile time */
+template<uint32_t Hash>
+struct TagHash {
+    static constexpr uint32_t value = Hash;
+};
+
+/* the tag with compile time hash value */
+struct Tag {
+    const char *name;
+    uint32_t hash;
+
+    constexpr explicit Tag(const char *name) : name(name), hash(elog::hash(name)) { }
+    constexpr Tag(const char *name, uint32_t hash) : name(name), hash(hash) { }
+};
+
+} /* namespace elog */
+
+/* the tag which is hashed at compile time, it's a string literal */
+#define ELOG_TAG(name)                       (::elog::Tag((name), ::elog::TagHash<::elog::hash(name)>::value))
+
+#if defined(ELOG_OUTPUT_ENABLE) && defined(ELOG_USING_SPAN)
+namespace elog {
+
+/* the timing span which ends when it's destroyed, it's used by ELOG_SPAN */
+class Span {
+public:
+    Span(uint8_t level, const Tag &tag, const char *name, const char *file, const char *func, long line) : tag_(tag) {
+        if (level <= ELOG_OUTPUT_LVL) {
+            elog_span_begin(&span_, level, tag_.name, &tag_.hash, name, file, func, line);
+        } else {
+            span_.enabled = false;
+        }
+    }
+
+    ~Span() {
+        elog_span_end(&span_);
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+private:
+    /* the span saves the pointer of tag hash value */
+    Tag tag_;
+    ElogSpan span_;
+};
+
+} /* namespace elog */
+
+/* the scoped span, the tag can be a string or ELOG_TAG */
+#define ELOG_SPAN(level, tag, name) \
+        ::elog::Span ELOG_SPAN_VAR(__LINE__)((level), ::elog::Tag(tag), (name), ELOG_FILE, __FUNCTION__, __LINE__)
+#endif /* defined(ELOG_OUTPUT_ENABLE) && defined(ELOG_USING_SPAN) */
+
+/**
+ * output the log with elog::Tag, it's called by elog_a ~ elog_v
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+template<typename... Args>
+inline void elog_output(uint8_t level, const elog::Tag &tag, const char *file, const char *func,
+        const long line, const char *format, Args... args) {
+    elog_output_hash(level, tag.name, tag.hash, file, func, line, format, args...);
+}
+
+#ifdef ELOG_USING_ISR
+/**
+ * output the log in ISR with elog::Tag, it's called by elog_isr_a ~ elog_isr_v
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+template<typename... Args>
+inline void elog_isr_output(uint8_t level, const elog::Tag &tag, const char *file, const char *func,
+        const long line, const char *format, Args... args) {
+    elog_isr_output_hash(level, tag.name, tag.hash, file, func, line, format, args...);
+}
+#endif /* ELOG_USING_ISR */
+
+#if __cplusplus >= 202002L
+
+/* the caller's location for type safe API */
+#if defined(__GNUC__) || defined(__clang__)
+#define ELOG_CALLER_FILE                     __builtin_FILE()
+#define ELOG_CALLER_FUNC                     __builtin_FUNCTION()
+#define ELOG_CALLER_LINE                     __builtin_LINE()
+#else
+#define ELOG_CALLER_FILE                     ""
+#define ELOG_CALLER_FUNC                     ""
+#define ELOG_CALLER_LINE                     0
+#endif
+
+namespace elog {
+
+namespace detail {
+
+/* it makes the argument can't be deduced */
+template<typename T>
+struct Identity {
+    using type = T;
+};
+
+/**
+ * It's not constexpr, so it's a compile error when it's called by the consteval format parser.
+ *
+ * @param reason error reason, it's shown in the compiler's error message
+ */
+void format_error(const char *reason);
+
+/**
+ * get the file name without directory, it's calculated at compile time
+ *
+ * @param path file path
+ *
+ * @return file name
+ */
+constexpr const char *file_name(const char *path) {
+    const char *name = path;
+
+    for (; *path; path++) {
+        if (*path == '/' || *path == '\\') {
+            name = path + 1;
+        }
+    }
+
+    return name;
+}
+
+/* the log buffer writer, the log will be truncated when the buffer is full */
+struct Writer {
+    char *cur;
+    char *end;
+
+    void put(char c) {
+        if (cur < end) {
+            *cur++ = c;
+        }
+    }
+
+    void put(const char *str, size_t size) {
+        if (size > static_cast<size_t>(end - cur)) {
+            size = end - cur;
+        }
+        memcpy(cur, str, size);
+        cur += size;
+    }
+};
+
+/**
+ * write unsigned integer
+ *
+ * @param w writer
+ * @param value value
+ * @param hex true: hex format
+ */
+inline void write_unsigned(Writer &w, unsigned long long value, bool hex) {
+    char num[20];
+    size_t i = sizeof(num);
+
+    do {
+        num[--i] = "0123456789abcdef"[hex ? value % 16 : value % 10];
+        value = hex ? value / 16 : value / 10;
+    } while (value);
+    w.put(num + i, sizeof(num) - i);
+}
+
+inline void write_arg(Writer &w, char spec, bool value) {
+    (void) spec;
+    w.put(value ? "true" : "false", value ? 4 : 5);
+}
+
+inline void write_arg(Writer &w, char spec, char value) {
+    (void) spec;
+    w.put(value);
+}
+
+inline void write_arg(Writer &w, char spec, const char *value) {
+    (void) spec;
+    if (!value) {
+        value = "(null)";
+    }
+    w.put(value, strlen(value));
+}
+
+inline void write_arg(Writer &w, char spec, const void *value) {
+    (void) spec;
+    w.put("0x", 2);
+    write_unsigned(w, reinterpret_cast<uintptr_t>(value), true);
+}
+
+inline void write_arg(Writer &w, char spec, double value) {
+    char num[32];
+    unsigned long long int_part, frac_part, scale = 1;
+    int precision = (spec >= '0' && spec <= '9') ? spec - '0' : 6, i;
+    double scaled, rest, error;
+    bool round_up;
+
+    if (value != value) {
+        w.put("nan", 3);
+        return;
+    }
+    if (value < 0) {
+        w.put('-');
+        value = -value;
+    }
+    if (value >= 1e18) {
+        /* it's out of integer range, it's rarely used */
+        w.put(num, snprintf(num, sizeof(num), "%g", value));
+        return;
+    }
+    for (i = 0; i < precision; i++) {
+        scale *= 10;
+    }
+    int_part = static_cast<unsigned long long>(value);
+    scaled = (value - int_part) * scale;
+    frac_part = static_cast<unsigned long long>(scaled);
+    rest = scaled - frac_part;
+    if (rest == 0.5) {
+        /* the scaled fraction maybe rounded to a tie, so it's checked by the rounding error of the product.
+         * the exact tie is rounded to even as printf, the last digit is in integer part when precision is 0. */
+        error = std::fma(value - int_part, static_cast<double>(scale), -scaled);
+        round_up = error > 0 || (error == 0 && ((precision ? frac_part : int_part) & 1));
+    } else {
+        round_up = rest > 0.5;
+    }
+    if (round_up) {
+        frac_part++;
+    }
+    /* carry to the integer part when the fraction is rounded up to 1, such as 0.999 by 2 digits */
+    if (frac_part >= scale) {
+        int_part++;
+        frac_part -= scale;
+    }
+    write_unsigned(w, int_part, false);
+    if (precision) {
+        w.put('.');
+        /* the leading zero of fraction part */
+        for (scale /= 10; scale > frac_part && scale > 1; scale /= 10) {
+            w.put('0');
+        }
+        write_unsigned(w, frac_part, false);
+    }
+}
+
+/* long double is formatted as double */
+inline void write_arg(Writer &w, char spec, long double value) {
+    write_arg(w, spec, static_cast<double>(value));
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+write_arg(Writer &w, char spec, T value) {
+    if (spec == 'x') {
+        write_unsigned(w, static_cast<typename std::make_unsigned<T>::type>(value), true);
+    } else if (value < 0) {
+        w.put('-');
+        write_unsigned(w, 0ULL - static_cast<unsigned long long>(value), false);
+    } else {
+        write_unsigned(w, static_cast<unsigned long long>(value), false);
+    }
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+write_arg(Writer &w, char spec, T value) {
+    write_unsigned(w, value, spec == 'x');
+}
+
+template<typename T>
+inline typename std::enable_if<std::is_enum<T>::value>::type
+write_arg(Writer &w, char spec, T value) {
+    write_arg(w, spec, static_cast<typename std::underlying_type<T>::type>(value));
+}
+
+} /* namespace detail */
+
+/* the format string which is parsed at compile time */
+template<typename... Args>
+struct Format {
+    static constexpr size_t ARG_NUM = sizeof...(Args);
+
+    const char *str;
+    const char *file;
+    const char *func;
+    long line;
+    /* the literal segments around placeholders, the segment i is [seg_begin[i], seg_end[i]) */
+    uint16_t seg_begin[ARG_NUM + 1];
+    uint16_t seg_end[ARG_NUM + 1];
+    /* the segment has "{{" or "}}" */
+    bool seg_escape[ARG_NUM + 1];
+    /* placeholder spec, 0: default, 'x': hex, '0'~'9': floating point precision */
+    char spec[ARG_NUM + 1];
+
+    template<size_t N>
+    consteval Format(const char (&format)[N], const char *file = ELOG_CALLER_FILE,
+            const char *func = ELOG_CALLER_FUNC, long line = ELOG_CALLER_LINE) :
+            str(format), file(detail::file_name(file)), func(func), line(line), seg_begin(), seg_end(), seg_escape(), spec() {
+        size_t i = 0, arg = 0;
+
+        while (i < N - 1) {
+            if ((format[i] == '{' && format[i + 1] == '{') || (format[i] == '}' && format[i + 1] == '}')) {
+                seg_escape[arg] = true;
+                i += 2;
+            } else if (format[i] == '}') {
+                detail::format_error("unmatched '}' in format string");
+                return;
+            } else if (format[i] != '{') {
+                i++;
+            } else {
+                if (arg >= ARG_NUM) {
+                    detail::format_error("too few arguments for format string");
+                    return;
+                }
+                seg_end[arg] = static_cast<uint16_t>(i++);
+                if (format[i] == ':') {
+                    if (format[i + 1] == 'x') {
+                        spec[arg] = 'x';
+                        i += 2;
+                    } else if (format[i + 1] == '.' && format[i + 2] >= '0' && format[i + 2] <= '9') {
+                        spec[arg] = format[i + 2];
+                        i += 3;
+                    }
+                }
+                if (format[i] != '}') {
+                    detail::format_error("unsupported placeholder in format string");
+                    return;
+                }
+                seg_begin[++arg] = static_cast<uint16_t>(++i);
+            }
+        }
+        seg_end[arg] = static_cast<uint16_t>(N - 1);
+        if (arg != ARG_NUM) {
+            detail::format_error("too many arguments for format string");
+        }
+    }
+
+    /**
+     * write the literal segment
+     *
+     * @param w writer
+     * @param index segment index
+     */
+    void write_segment(detail::Writer &w, size_t index) const {
+        size_t i;
+
+        if (!seg_escape[index]) {
+            w.put(str + seg_begin[index], seg_end[index] - seg_begin[index]);
+            return;
+        }
+        for (i = seg_begin[index]; i < seg_end[index]; i++) {
+            w.put(str[i]);
+            /* skip the second brace */
+            if (str[i] == '{' || str[i] == '}') {
+                i++;
+            }
+        }
+    }
+};
+
+namespace detail {
+
+/**
+ * format and output the log by type safe API
+ *
+ * @param tag tag
+ * @param format format string
+ * @param args args
+ */
+template<uint8_t Level, typename... Args>
+inline void output(const Tag &tag, const Format<Args...> &format, const Args &... args) {
+#ifdef ELOG_OUTPUT_ENABLE
+    if (Level <= ELOG_OUTPUT_LVL && elog_output_check(Level, tag.name, &tag.hash)) {
+        char buf[ELOG_BUF_SIZE];
+        Writer w = { buf, buf + sizeof(buf) - 1 };
+        size_t index = 0;
+        int expand[] = { 0, (format.write_segment(w, index), write_arg(w, format.spec[index], args), index++, 0)... };
+
+        (void) expand;
+        format.write_segment(w, index);
+        *w.cur = '\0';
+        elog_output_str(Level, tag.name, &tag.hash, format.file, format.func, format.line, buf);
+    }
+#else
+    (void) tag;
+    (void) format;
+    int expand[] = { 0, ((void) args, 0)... };
+    (void) expand;
+#endif
+}
+
+} /* namespace detail */
+
+/* type safe log output API */
+template<typename... Args>
+inline void a(const Tag &tag, Format<typename detail::Identity<Args>::type...> format, const Args &... args) {
+    detail::output<ELOG_LVL_ASSERT>(tag, format, args...);
+}
+
+template<typename... Args>
+inline void e(const Tag &tag, Format<typename detail::Identity<Args>::type...> format, const Args &... args) {
+    detail::output<ELOG_LVL_ERROR>(tag, format, args...);
+}
+
+template<typename... Args>
+inline void w(const Tag &tag, Format<typename detail::Identity<Args>::type...> format, const Args &... args) {
+    detail::output<ELOG_LVL_WARN>(tag, format, args...);
+}
+
+template<typename... Args>
+inline void i(const Tag &tag, Format<typename detail::Identity<Args>::type...> format, const Args &... args) {
+    detail::output<ELOG_LVL_INFO>(tag, format, args...);
+}
+
+template<typename... Args>
+inline void d(const Tag &tag, Format<typename detail::Identity<Args>::type...> format, const Args &... args) {
+    detail::output<ELOG_LVL_DEBUG>(tag, format, args...);
+}
+
+template<typename... Args>
+inline void v(const Tag &tag, Format<typename detail::Identity<Args>::type...> format, const Args &... args) {
+    detail::output<ELOG_LVL_VERBOSE>(tag, format, args...);
+}
+
+} /* namespace elog */
+
+#endif /* __cplusplus >= 202002L */
+
+#endif /* __ELOG_HPP__ */
@@ -0,0 +1,265 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Save the logs to memory mapped file on Linux. There is no system call when the log is written.
+ * Created on: 2026-10-19
+ *
+ * The log file is preallocated and mapped by ELOG_FILE_MAP_SIZE. The writer reserves the space by an
+ * atomic add on the write cursor, which is made up by file generation (high 32 bits) and offset
+ * (low 32 bits), then copies the log to mapping without lock. The writer whose log overflows the
+ * file first rolls the file: it waits for the reserved logs are copied, cuts the unused space, renames
+ * the files and maps a new file. The other overflowed writers wait for the new file.
+ * The logs are in page cache after copied, so they won't be lost when the process crashes. The
+ * unused space of the crashed file is cut when it's initialized next time.
+ */
+
+#define _GNU_SOURCE
+#include "elog_file.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* the file generation and offset in write cursor */
+#define CURSOR_GEN(cursor)                   ((cursor) >> 32)
+#define CURSOR_OFFSET(cursor)                ((size_t) ((cursor) & 0xFFFFFFFFULL))
+#define CURSOR_MAKE(gen)                     ((uint64_t) (gen) << 32)
+/* rolled file path max length, the path with ".N" suffix */
+#define FILE_PATH_MAX_LEN                    (sizeof(ELOG_FILE_PATH) + 8)
+
+/* mapped log file */
+typedef struct {
+    int fd;
+    char *base;
+    /* the copied bytes, the file can be rolled when all reserved bytes are copied */
+    size_t committed;
+} ElogFileMap, *ElogFileMap_t;
+
+/* the mapped file of even and odd generation, the old one is used until all writers are finished */
+static ElogFileMap maps[2];
+/* write cursor, it's made up by file generation and offset */
+static uint64_t cursor = 0;
+/* the new file can't be mapped when rolling, the logs will be dropped */
+static bool broken = false;
+/* initialize OK flag */
+static bool init_ok = false;
+
+static ElogFileErrCode open_map(ElogFileMap_t map);
+static void close_map(ElogFileMap_t map, size_t size);
+static void roll_file(uint64_t gen, size_t size);
+static void rename_files(void);
+static void trim_file(void);
+
+/**
+ * File log initialize. The last file is trimmed and rolled, then a new file is mapped.
+ *
+ * @return result
+ */
+ElogFileErrCode elog_file_init(void) {
+    ElogFileErrCode result;
+
+    ELOG_ASSERT(ELOG_FILE_MAP_SIZE < 0xFFFFFFFFUL);
+    ELOG_ASSERT(ELOG_FILE_ROLL_NUM < 100000);
+
+    if (init_ok) {
+        return ELOG_FILE_NO_ERR;
+    }
+
+    /* the last file maybe isn't closed when the process crashed */
+    trim_file();
+    rename_files();
+
+    result = open_map(&maps[0]);
+    if (result == ELOG_FILE_NO_ERR) {
+        cursor = CURSOR_MAKE(0);
+        broken = false;
+        init_ok = true;
+    }
+
+    return result;
+}
+
+/**
+ * Write the log to file. It can be called by multiple threads without lock.
+ *
+ * @param log log
+ * @param size log size
+ */
+void elog_file_write(const char *log, size_t size) {
+    ElogFileMap_t map;
+    uint64_t pos;
+    size_t offset;
+
+    if (!init_ok || size == 0 || size > ELOG_FILE_MAP_SIZE) {
+        return;
+    }
+
+    while (!__atomic_load_n(&broken, __ATOMIC_ACQUIRE)) {
+        pos = __atomic_fetch_add(&cursor, size, __ATOMIC_ACQUIRE);
+        map = &maps[CURSOR_GEN(pos) & 1];
+        offset = CURSOR_OFFSET(pos);
+        if (offset + size <= ELOG_FILE_MAP_SIZE) {
+            memcpy(map->base + offset, log, size);
+            __atomic_fetch_add(&map->committed, size, __ATOMIC_RELEASE);
+            return;
+        } else if (offset <= ELOG_FILE_MAP_SIZE) {
+            /* this log is the first one which overflows the file */
+            roll_file(CURSOR_GEN(pos), offset);
+        } else {
+            /* wait for the file is rolled by the first overflowed writer */
+            while (CURSOR_GEN(__atomic_load_n(&cursor, __ATOMIC_ACQUIRE)) == CURSOR_GEN(pos)
+                    && !__atomic_load_n(&broken, __ATOMIC_ACQUIRE)) {
+                sched_yield();
+            }
+        }
+    }
+}
+
+/**
+ * Close the file, the unused space is cut. The logs can't be written when it's closing.
+ */
+void elog_file_deinit(void) {
+    size_t offset = CURSOR_OFFSET(cursor);
+
+    if (!init_ok) {
+        return;
+    }
+
+    if (!broken) {
+        close_map(&maps[CURSOR_GEN(cursor) & 1], offset < ELOG_FILE_MAP_SIZE ? offset : ELOG_FILE_MAP_SIZE);
+    }
+    init_ok = false;
+}
+
+/**
+ * create, preallocate and map the log file
+ *
+ * @param map mapped file
+ *
+ * @return result
+ */
+static ElogFileErrCode open_map(ElogFileMap_t map) {
+    int result;
+
+    map->fd = open(ELOG_FILE_PATH, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (map->fd < 0) {
+        return ELOG_FILE_OPEN_ERR;
+    }
+    /* the space must be allocated, otherwise the store to mapping will get SIGBUS when disk is full */
+    result = fallocate(map->fd, 0, 0, ELOG_FILE_MAP_SIZE) ? errno : 0;
+    if (result == EOPNOTSUPP) {
+        result = posix_fallocate(map->fd, 0, ELOG_FILE_MAP_SIZE);
+    }
+    if (result) {
+        close(map->fd);
+        return ELOG_FILE_ALLOC_ERR;
+    }
+    map->base = mmap(NULL, ELOG_FILE_MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, map->fd, 0);
+    if (map->base == MAP_FAILED) {
+        close(map->fd);
+        return ELOG_FILE_MAP_ERR;
+    }
+    map->committed = 0;
+
+    return ELOG_FILE_NO_ERR;
+}
+
+/**
+ * unmap and close the log file, the unused space is cut
+ *
+ * @param map mapped file
+ * @param size used size
+ */
+static void close_map(ElogFileMap_t map, size_t size) {
+    munmap(map->base, ELOG_FILE_MAP_SIZE);
+    if (ftruncate(map->fd, size)) {
+        /* the unused space is kept, it's filled with '\0' */
+    }
+    close(map->fd);
+}
+
+/**
+ * Roll the file by the first overflowed writer. The new file is mapped to the other generation,
+ * then the writers can reserve space from it.
+ *
+ * @param gen current file generation
+ * @param size the reserved size before the overflowed log, it's the used size of current file
+ */
+static void roll_file(uint64_t gen, size_t size) {
+    ElogFileMap_t old_map = &maps[gen & 1], new_map = &maps[(gen + 1) & 1];
+
+    /* wait for the reserved logs are copied */
+    while (__atomic_load_n(&old_map->committed, __ATOMIC_ACQUIRE) != size) {
+        sched_yield();
+    }
+    close_map(old_map, size);
+    rename_files();
+    if (open_map(new_map) != ELOG_FILE_NO_ERR) {
+        __atomic_store_n(&broken, true, __ATOMIC_RELEASE);
+        return;
+    }
+    __atomic_store_n(&cursor, CURSOR_MAKE(gen + 1), __ATOMIC_RELEASE);
+}
+
+/**
+ * rename the log files: "<path>.N-1" -> "<path>.N", ..., "<path>" -> "<path>.1", the oldest one is removed
+ */
+static void rename_files(void) {
+    char old_path[FILE_PATH_MAX_LEN], new_path[FILE_PATH_MAX_LEN];
+    int i;
+
+    for (i = ELOG_FILE_ROLL_NUM - 1; i > 0; i--) {
+        snprintf(old_path, sizeof(old_path), "%s.%d", ELOG_FILE_PATH, i);
+        snprintf(new_path, sizeof(new_path), "%s.%d", ELOG_FILE_PATH, i + 1);
+        rename(old_path, new_path);
+    }
+    if (ELOG_FILE_ROLL_NUM > 0) {
+        snprintf(new_path, sizeof(new_path), "%s.1", ELOG_FILE_PATH);
+        rename(ELOG_FILE_PATH, new_path);
+    }
+}
+
+/**
+ * cut the unused space of the last file which is filled with '\0', it's left when the process crashed
+ */
+static void trim_file(void) {
+    struct stat st;
+    const char *base;
+    size_t size;
+    int fd;
+
+    fd = open(ELOG_FILE_PATH, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED) {
+            for (size = st.st_size; size > 0 && base[size - 1] == '\0'; size--);
+            munmap((void *) base, st.st_size);
+            if (size < (size_t) st.st_size && ftruncate(fd, size)) {
+                /* keep the file as is */
+            }
+        }
+    }
+    close(fd);
+}
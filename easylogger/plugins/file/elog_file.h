@@ -0,0 +1,73 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: It is an head file for file log plugin (Linux). You can see all be called functions.
+ *           The logs can be saved by memory mapped file (elog_file.c) or io_uring (elog_file_uring.c).
+ * Created on: 2026-10-19
+ */
+
+#ifndef __ELOG_FILE_H__
+#define __ELOG_FILE_H__
+
+#include "elog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* log file path, the full file is renamed to "<path>.1", and the older files are "<path>.2" ~ "<path>.N" */
+#define ELOG_FILE_PATH                       "/tmp/elog.log"
+/* max rolled file number, the oldest file will be removed */
+#define ELOG_FILE_ROLL_NUM                   4
+/* log file size, the file is preallocated and mapped to memory by this size */
+#define ELOG_FILE_MAP_SIZE                   (4 * 1024 * 1024)
+/* io_uring file log buffer number, the buffers are registered to kernel and written asynchronously in turn */
+#define ELOG_FILE_URING_BUF_NUM              4
+/* io_uring file log buffer size, the buffer is written to file by one write when it's full or flushed */
+#define ELOG_FILE_URING_BUF_SIZE             (64 * 1024)
+/* io_uring file log flush time (ms), the buffer is submitted by next write when it's first log is older than it */
+#define ELOG_FILE_URING_FLUSH_MS             1000
+/* file log plugin version number */
+#define ELOG_FILE_SW_VERSION                 "0.10.19"
+
+/* file log plugin error code */
+typedef enum {
+    ELOG_FILE_NO_ERR,
+    ELOG_FILE_OPEN_ERR,
+    ELOG_FILE_ALLOC_ERR,
+    ELOG_FILE_MAP_ERR,
+    ELOG_FILE_URING_ERR,
+} ElogFileErrCode;
+
+/* elog_file.c */
+ElogFileErrCode elog_file_init(void);
+void elog_file_write(const char *log, size_t size);
+void elog_file_deinit(void);
+
+/* elog_file_uring.c */
+ElogFileErrCode elog_file_uring_init(void);
+void elog_file_uring_write(const char *log, size_t size);
+void elog_file_uring_flush(void);
+size_t elog_file_uring_get_dropped(void);
+void elog_file_uring_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_FILE_H__ */
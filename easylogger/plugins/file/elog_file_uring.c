@@ -0,0 +1,462 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Save the logs to file by io_uring on Linux. The writer never waits for the storage.
+ * Created on: 2026-10-19
+ *
+ * The logs are copied to one of the ELOG_FILE_URING_BUF_NUM buffers which are registered to kernel.
+ * When the buffer is full or flushed, it's submitted as a fixed buffer write with it's own file
+ * offset, then the next free buffer is used, so there can be multiple writes in flight and the file
+ * is still in order. The completions are reaped without waiting in next write. The log is dropped
+ * and counted when all buffers are in flight.
+ * The current buffer is submitted by elog_flush (the flush hook) or by next write after
+ * ELOG_FILE_URING_FLUSH_MS, so the logs aren't kept in RAM for long time.
+ * When a write is failed, the file is compacted: the later buffers are moved to the lost logs'
+ * offset and written again after all writes to the old offsets are completed, then the file is
+ * truncated when there is no write in flight, so there isn't any hole in the file.
+ * The io_uring is used by system calls directly, it doesn't need liburing.
+ */
+
+#define _GNU_SOURCE
+#include "elog_file.h"
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/* log buffer */
+typedef struct {
+    char *data;
+    /* log length in buffer */
+    size_t len;
+    /* the written length, the rest will be submitted again after a short write */
+    size_t done;
+    /* the file offset of buffer */
+    uint64_t offset;
+    /* it's submitted and not completed */
+    bool busy;
+    /* it's moved by compaction when it's in flight, it will be written to new offset again */
+    bool moved;
+    /* it's moved and the write to old offset is completed, it waits for the other moved buffers */
+    bool pending;
+} ElogUringBuf, *ElogUringBuf_t;
+
+/* io_uring which is mapped from kernel */
+typedef struct {
+    int fd;
+    void *sq_ptr, *cq_ptr;
+    size_t sq_size, cq_size;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    struct io_uring_cqe *cqes;
+} ElogUring, *ElogUring_t;
+
+static char buf_data[ELOG_FILE_URING_BUF_NUM][ELOG_FILE_URING_BUF_SIZE];
+static ElogUringBuf bufs[ELOG_FILE_URING_BUF_NUM];
+/* the buffer which the log is copied to */
+static size_t cur_buf = 0;
+/* the time (ms) of the first log in current buffer */
+static uint32_t cur_buf_ms = 0;
+static ElogUring uring;
+static int file_fd = -1;
+/* the file offset of next submitted buffer */
+static uint64_t file_offset = 0;
+/* dropped log number since last get, a failed write is counted as one */
+static size_t dropped_num = 0;
+/* the number of moved buffers which are writing to the old offset, nothing is submitted until it's 0 */
+static size_t moved_num = 0;
+/* the file has the stale logs after file_offset by compaction, it will be truncated */
+static bool need_truncate = false;
+/* initialize OK flag */
+static bool init_ok = false;
+
+static ElogFileErrCode uring_setup(void);
+static void uring_release(void);
+static void submit_buf(size_t index);
+static void reap(bool wait);
+static void compact(size_t index);
+static void next_buf(void);
+
+/**
+ * io_uring file log initialize. The logs are appended to ELOG_FILE_PATH.
+ *
+ * @return result
+ */
+ElogFileErrCode elog_file_uring_init(void) {
+    ElogFileErrCode result;
+    struct iovec iov[ELOG_FILE_URING_BUF_NUM];
+    off_t size;
+    size_t i;
+
+    if (init_ok) {
+        return ELOG_FILE_NO_ERR;
+    }
+
+    file_fd = open(ELOG_FILE_PATH, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (file_fd < 0) {
+        return ELOG_FILE_OPEN_ERR;
+    }
+    size = lseek(file_fd, 0, SEEK_END);
+    file_offset = size > 0 ? (uint64_t) size : 0;
+
+    result = uring_setup();
+    if (result != ELOG_FILE_NO_ERR) {
+        close(file_fd);
+        return result;
+    }
+
+    /* the registered buffers are pinned by kernel, they needn't be mapped for each write */
+    for (i = 0; i < ELOG_FILE_URING_BUF_NUM; i++) {
+        bufs[i].data = buf_data[i];
+        bufs[i].len = 0;
+        bufs[i].busy = false;
+        bufs[i].moved = false;
+        bufs[i].pending = false;
+        iov[i].iov_base = buf_data[i];
+        iov[i].iov_len = ELOG_FILE_URING_BUF_SIZE;
+    }
+    if (syscall(__NR_io_uring_register, uring.fd, IORING_REGISTER_BUFFERS, iov, ELOG_FILE_URING_BUF_NUM) < 0) {
+        uring_release();
+        close(file_fd);
+        return ELOG_FILE_URING_ERR;
+    }
+    cur_buf = 0;
+    dropped_num = 0;
+    moved_num = 0;
+    need_truncate = false;
+    init_ok = true;
+    /* the current buffer is submitted by elog_flush */
+    elog_set_flush_hook(elog_file_uring_flush);
+
+    return ELOG_FILE_NO_ERR;
+}
+
+/**
+ * Write the log to file asynchronously. The log is dropped when all buffers are in flight.
+ * The caller must hold the output lock.
+ *
+ * @param log log
+ * @param size log size
+ */
+void elog_file_uring_write(const char *log, size_t size) {
+    ElogUringBuf_t buf;
+
+    if (!init_ok || size == 0) {
+        return;
+    }
+
+    reap(false);
+
+    buf = &bufs[cur_buf];
+    /* the log isn't split, it's written to next buffer when current buffer hasn't enough space */
+    if (!buf->busy && buf->len + size > ELOG_FILE_URING_BUF_SIZE) {
+        next_buf();
+        buf = &bufs[cur_buf];
+    }
+    /* the current buffer maybe full when the submission is delayed by compaction */
+    if (buf->busy || buf->len + size > ELOG_FILE_URING_BUF_SIZE) {
+        dropped_num++;
+        return;
+    }
+
+    if (buf->len == 0) {
+        cur_buf_ms = elog_port_get_ms();
+    }
+    memcpy(buf->data + buf->len, log, size);
+    buf->len += size;
+    if (buf->len == ELOG_FILE_URING_BUF_SIZE || elog_port_get_ms() - cur_buf_ms >= ELOG_FILE_URING_FLUSH_MS) {
+        next_buf();
+    }
+}
+
+/**
+ * Submit the logs in current buffer, it doesn't wait for the write.
+ * It's set as the flush hook by elog_file_uring_init, so it's called by elog_flush.
+ * The caller must hold the output lock.
+ */
+void elog_file_uring_flush(void) {
+    if (!init_ok) {
+        return;
+    }
+
+    reap(false);
+    next_buf();
+}
+
+/**
+ * get the dropped log number since last get
+ * The caller must hold the output lock.
+ *
+ * @return dropped log number
+ */
+size_t elog_file_uring_get_dropped(void) {
+    size_t dropped = dropped_num;
+
+    dropped_num = 0;
+
+    return dropped;
+}
+
+/**
+ * Flush the logs and wait for all writes are completed, then close the file.
+ * The caller must hold the output lock.
+ */
+void elog_file_uring_deinit(void) {
+    size_t i;
+
+    if (!init_ok) {
+        return;
+    }
+
+    elog_set_flush_hook(NULL);
+    /* the current buffer can't be submitted until the compaction is finished */
+    while (moved_num > 0) {
+        reap(true);
+    }
+    next_buf();
+    for (i = 0; i < ELOG_FILE_URING_BUF_NUM; i++) {
+        while (bufs[i].busy) {
+            reap(true);
+        }
+    }
+    uring_release();
+    close(file_fd);
+    init_ok = false;
+}
+
+/**
+ * create the io_uring and map it's submission queue and completion queue
+ *
+ * @return result
+ */
+static ElogFileErrCode uring_setup(void) {
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    /* there are ELOG_FILE_URING_BUF_NUM writes in flight at most */
+    uring.fd = (int) syscall(__NR_io_uring_setup, ELOG_FILE_URING_BUF_NUM, &params);
+    if (uring.fd < 0) {
+        return ELOG_FILE_URING_ERR;
+    }
+
+    uring.sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    uring.cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (uring.cq_size > uring.sq_size) {
+            uring.sq_size = uring.cq_size;
+        }
+        uring.cq_size = uring.sq_size;
+    }
+    uring.sq_ptr = mmap(NULL, uring.sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+            IORING_OFF_SQ_RING);
+    if (uring.sq_ptr == MAP_FAILED) {
+        close(uring.fd);
+        return ELOG_FILE_URING_ERR;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring.cq_ptr = uring.sq_ptr;
+    } else {
+        uring.cq_ptr = mmap(NULL, uring.cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+                IORING_OFF_CQ_RING);
+        if (uring.cq_ptr == MAP_FAILED) {
+            munmap(uring.sq_ptr, uring.sq_size);
+            close(uring.fd);
+            return ELOG_FILE_URING_ERR;
+        }
+    }
+    uring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring.sqes = mmap(NULL, uring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd,
+            IORING_OFF_SQES);
+    if (uring.sqes == MAP_FAILED) {
+        if (uring.cq_ptr != uring.sq_ptr) {
+            munmap(uring.cq_ptr, uring.cq_size);
+        }
+        munmap(uring.sq_ptr, uring.sq_size);
+        close(uring.fd);
+        return ELOG_FILE_URING_ERR;
+    }
+
+    uring.sq_head = (unsigned *) ((char *) uring.sq_ptr + params.sq_off.head);
+    uring.sq_tail = (unsigned *) ((char *) uring.sq_ptr + params.sq_off.tail);
+    uring.sq_mask = (unsigned *) ((char *) uring.sq_ptr + params.sq_off.ring_mask);
+    uring.sq_array = (unsigned *) ((char *) uring.sq_ptr + params.sq_off.array);
+    uring.cq_head = (unsigned *) ((char *) uring.cq_ptr + params.cq_off.head);
+    uring.cq_tail = (unsigned *) ((char *) uring.cq_ptr + params.cq_off.tail);
+    uring.cq_mask = (unsigned *) ((char *) uring.cq_ptr + params.cq_off.ring_mask);
+    uring.cqes = (struct io_uring_cqe *) ((char *) uring.cq_ptr + params.cq_off.cqes);
+
+    return ELOG_FILE_NO_ERR;
+}
+
+/**
+ * unmap and close the io_uring
+ */
+static void uring_release(void) {
+    munmap(uring.sqes, uring.sqes_size);
+    if (uring.cq_ptr != uring.sq_ptr) {
+        munmap(uring.cq_ptr, uring.cq_size);
+    }
+    munmap(uring.sq_ptr, uring.sq_size);
+    close(uring.fd);
+}
+
+/**
+ * submit the rest logs of the buffer by fixed buffer write
+ *
+ * @param index buffer index
+ */
+static void submit_buf(size_t index) {
+    ElogUringBuf_t buf = &bufs[index];
+    struct io_uring_sqe *sqe;
+    unsigned tail, sqe_index;
+
+    tail = *uring.sq_tail;
+    sqe_index = tail & *uring.sq_mask;
+    sqe = &uring.sqes[sqe_index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = file_fd;
+    sqe->addr = (uint64_t) (uintptr_t) (buf->data + buf->done);
+    sqe->len = (uint32_t) (buf->len - buf->done);
+    sqe->off = buf->offset + buf->done;
+    sqe->buf_index = (uint16_t) index;
+    sqe->user_data = index;
+    uring.sq_array[sqe_index] = sqe_index;
+    /* the kernel can see the entry after the tail is updated */
+    __atomic_store_n(uring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+    buf->busy = true;
+
+    /* the entries which weren't submitted by last failed enter are submitted together */
+    syscall(__NR_io_uring_enter, uring.fd, tail + 1 - __atomic_load_n(uring.sq_head, __ATOMIC_ACQUIRE), 0, 0,
+            NULL, 0);
+}
+
+/**
+ * Reap the completed writes, then the buffers can be used again. The rest logs of short write are
+ * submitted again, the logs are dropped and the file is compacted when the write failed.
+ *
+ * @param wait wait for one write is completed at least
+ */
+static void reap(bool wait) {
+    struct io_uring_cqe *cqe;
+    ElogUringBuf_t buf;
+    unsigned head, tail;
+    size_t i;
+
+    if (wait) {
+        syscall(__NR_io_uring_enter, uring.fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    }
+
+    head = *uring.cq_head;
+    tail = __atomic_load_n(uring.cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        cqe = &uring.cqes[head & *uring.cq_mask];
+        buf = &bufs[cqe->user_data];
+        buf->busy = false;
+        if (buf->moved) {
+            /* the logs were written to the old offset, they will be written to the new offset again */
+            buf->moved = false;
+            buf->pending = true;
+            buf->busy = true;
+            moved_num--;
+            continue;
+        } else if (cqe->res > 0 && buf->done + cqe->res < buf->len) {
+            /* short write */
+            buf->done += cqe->res;
+            __atomic_store_n(uring.cq_head, head + 1, __ATOMIC_RELEASE);
+            submit_buf(cqe->user_data);
+            continue;
+        } else if (cqe->res <= 0) {
+            dropped_num++;
+            compact(cqe->user_data);
+        }
+        buf->len = 0;
+    }
+    __atomic_store_n(uring.cq_head, head, __ATOMIC_RELEASE);
+
+    if (moved_num > 0) {
+        return;
+    }
+    /* the old offsets won't be written anymore, the moved buffers can be written to the new offsets */
+    for (i = 0; i < ELOG_FILE_URING_BUF_NUM; i++) {
+        if (bufs[i].pending) {
+            bufs[i].pending = false;
+            bufs[i].done = 0;
+            submit_buf(i);
+        }
+    }
+    if (need_truncate) {
+        /* the stale logs after file offset maybe written by the write in flight */
+        for (i = 0; i < ELOG_FILE_URING_BUF_NUM; i++) {
+            if (bufs[i].busy) {
+                return;
+            }
+        }
+        if (ftruncate(file_fd, (off_t) file_offset) == 0) {
+            need_truncate = false;
+        }
+    }
+}
+
+/**
+ * Compact the file after the write of buffer is failed. The unwritten logs of the buffer are
+ * dropped, and the later buffers are moved forward by the dropped size, so there isn't any hole.
+ *
+ * @param index failed buffer index
+ */
+static void compact(size_t index) {
+    ElogUringBuf_t buf = &bufs[index];
+    uint64_t lost = buf->len - buf->done;
+    size_t i;
+
+    for (i = 0; i < ELOG_FILE_URING_BUF_NUM; i++) {
+        if (bufs[i].busy && bufs[i].offset > buf->offset) {
+            bufs[i].offset -= lost;
+            if (!bufs[i].moved && !bufs[i].pending) {
+                bufs[i].moved = true;
+                moved_num++;
+            }
+            need_truncate = true;
+        }
+    }
+    file_offset -= lost;
+}
+
+/**
+ * submit current buffer when it has logs, then use the next buffer
+ */
+static void next_buf(void) {
+    ElogUringBuf_t buf = &bufs[cur_buf];
+
+    /* the new offset maybe written by the moved buffer's write to old offset */
+    if (buf->busy || buf->len == 0 || moved_num > 0) {
+        return;
+    }
+
+    buf->offset = file_offset;
+    buf->done = 0;
+    buf->moved = false;
+    file_offset += buf->len;
+    submit_buf(cur_buf);
+    cur_buf = (cur_buf + 1) % ELOG_FILE_URING_BUF_NUM;
+}
@@ -0,0 +1,336 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Save the logs to flash. The logs are written by page and the sectors are used in turn.
+ * Created on: 2026-10-19
+ *
+ * Flash log area layout:
+ *
+ * | sector 0                                    | sector 1      | ... | sector N-1    |
+ * | sector head | page 0 | page 1 | ... | page n | sector head...|     |               |
+ *
+ * The sector head is made up by magic word and sequence number. The newest sector has the max
+ * sequence number, and the next sector is the oldest which will be erased and reused when the
+ * newest sector is full, so all sectors have the same erase times.
+ * The page head is made up by magic word (high 16 bits) and log length (low 16 bits). The pages
+ * in a sector are written in order, so the first erased page can be found by binary search.
+ */
+
+#include "elog_flash.h"
+#include <string.h>
+
+/* sector head magic word, it's "ELOG" */
+#define SECTOR_MAGIC                         0x454C4F47
+/* page head magic word, it's "LG" */
+#define PAGE_MAGIC                           0x4C47
+/* the value of erased flash word */
+#define ERASED_WORD                          0xFFFFFFFF
+/* sector head size */
+#define SECTOR_HEAD_SIZE                     8
+/* page head size */
+#define PAGE_HEAD_SIZE                       4
+/* log data size in a page */
+#define PAGE_DATA_SIZE                       (ELOG_FLASH_PAGE_SIZE - PAGE_HEAD_SIZE)
+/* page number in a sector */
+#define SECTOR_PAGE_NUM                      ((ELOG_FLASH_SECTOR_SIZE - SECTOR_HEAD_SIZE) / ELOG_FLASH_PAGE_SIZE)
+/* sector start address */
+#define SECTOR_ADDR(index)                   (ELOG_FLASH_START_ADDR + (index) * ELOG_FLASH_SECTOR_SIZE)
+/* page start address */
+#define PAGE_ADDR(sector, page)              (SECTOR_ADDR(sector) + SECTOR_HEAD_SIZE + (page) * ELOG_FLASH_PAGE_SIZE)
+
+/* sector head */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+} ElogFlashSectorHead, *ElogFlashSectorHead_t;
+
+/* the newest sector index and its sequence number */
+static size_t cur_sector = 0;
+static uint32_t cur_seq = 0;
+/* the first erased page in the newest sector */
+static size_t cur_page = 0;
+/* page buffer, it will be written to flash when it is full */
+static uint32_t page_buf[ELOG_FLASH_PAGE_SIZE / 4];
+/* log length in page buffer */
+static size_t page_len = 0;
+/* initialize OK flag */
+static bool init_ok = false;
+
+static bool page_is_erased(size_t sector, size_t page);
+static ElogFlashErrCode start_sector(size_t sector, uint32_t seq);
+static ElogFlashErrCode write_page(void);
+
+/**
+ * Flash log initialize. The newest sector is found by sector heads and the first erased page
+ * is found by binary search, so it doesn't need scan the whole log area.
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_init(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+    ElogFlashSectorHead head;
+    bool found = false;
+    size_t i, low, high, mid;
+
+    ELOG_ASSERT(ELOG_FLASH_PAGE_SIZE % 4 == 0);
+    ELOG_ASSERT(SECTOR_PAGE_NUM > 0);
+
+    /* find the newest sector */
+    for (i = 0; i < ELOG_FLASH_SECTOR_NUM; i++) {
+        result = elog_flash_port_read(SECTOR_ADDR(i), &head, sizeof(head));
+        if (result != ELOG_FLASH_NO_ERR) {
+            return result;
+        }
+        if (head.magic == SECTOR_MAGIC && (!found || (int32_t) (head.seq - cur_seq) > 0)) {
+            cur_sector = i;
+            cur_seq = head.seq;
+            found = true;
+        }
+    }
+
+    if (found) {
+        /* find the first erased page, the written pages are always before it */
+        low = 0;
+        high = SECTOR_PAGE_NUM;
+        while (low < high) {
+            mid = (low + high) / 2;
+            if (page_is_erased(cur_sector, mid)) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        cur_page = low;
+    } else {
+        /* the log area is not used */
+        result = start_sector(0, 0);
+    }
+    page_len = 0;
+
+    if (result == ELOG_FLASH_NO_ERR) {
+        init_ok = true;
+    }
+
+    return result;
+}
+
+/**
+ * Write log to flash. The log will be cached to page buffer until it is full.
+ * The caller must hold the output lock.
+ *
+ * @param log log
+ * @param size log size
+ */
+void elog_flash_write(const char *log, size_t size) {
+    size_t copy_size;
+
+    if (!init_ok) {
+        return;
+    }
+
+    while (size) {
+        copy_size = PAGE_DATA_SIZE - page_len;
+        if (copy_size > size) {
+            copy_size = size;
+        }
+        memcpy((char *) page_buf + PAGE_HEAD_SIZE + page_len, log, copy_size);
+        page_len += copy_size;
+        log += copy_size;
+        size -= copy_size;
+        /* the page buffer is full */
+        if (page_len == PAGE_DATA_SIZE) {
+            write_page();
+        }
+    }
+}
+
+/**
+ * write the cached logs in page buffer to flash
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_flush(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    if (!init_ok) {
+        return result;
+    }
+
+    /* lock output */
+    elog_port_output_lock();
+
+    if (page_len) {
+        result = write_page();
+    }
+
+    /* unlock output */
+    elog_port_output_unlock();
+
+    return result;
+}
+
+/**
+ * erase all logs in flash
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_clean(void) {
+    ElogFlashErrCode result;
+
+    /* lock output */
+    elog_port_output_lock();
+
+    result = elog_flash_port_erase(ELOG_FLASH_START_ADDR, ELOG_FLASH_SECTOR_SIZE * ELOG_FLASH_SECTOR_NUM);
+    if (result == ELOG_FLASH_NO_ERR) {
+        result = start_sector(0, cur_seq + 1);
+    }
+    page_len = 0;
+
+    /* unlock output */
+    elog_port_output_unlock();
+
+    return result;
+}
+
+/**
+ * initialize the iterator, it will read the logs from the oldest to the newest
+ *
+ * @param iter iterator
+ */
+void elog_flash_iter_init(ElogFlashIter_t iter) {
+    /* the next sector of the newest sector is the oldest */
+    iter->sector = (cur_sector + 1) % ELOG_FLASH_SECTOR_NUM;
+    iter->page = 0;
+    iter->read_sectors = 0;
+}
+
+/**
+ * Read the next page logs. The cached logs in page buffer can't be read until they are flushed.
+ *
+ * @param iter iterator
+ * @param buf buffer, it's size should be greater than or equal to ELOG_FLASH_PAGE_SIZE
+ * @param size buffer size
+ *
+ * @return read log size, 0: the end of logs
+ */
+size_t elog_flash_iter_next(ElogFlashIter_t iter, char *buf, size_t size) {
+    ElogFlashSectorHead sector_head;
+    uint32_t page_head;
+    size_t len;
+
+    while (iter->read_sectors < ELOG_FLASH_SECTOR_NUM) {
+        if (iter->page == 0) {
+            if (elog_flash_port_read(SECTOR_ADDR(iter->sector), &sector_head, sizeof(sector_head))
+                    != ELOG_FLASH_NO_ERR) {
+                return 0;
+            }
+        }
+        /* the sector isn't used or all pages has been read */
+        if ((iter->page == 0 && sector_head.magic != SECTOR_MAGIC) || iter->page >= SECTOR_PAGE_NUM
+                || elog_flash_port_read(PAGE_ADDR(iter->sector, iter->page), &page_head, sizeof(page_head))
+                        != ELOG_FLASH_NO_ERR || page_head == ERASED_WORD) {
+            iter->sector = (iter->sector + 1) % ELOG_FLASH_SECTOR_NUM;
+            iter->page = 0;
+            iter->read_sectors++;
+            continue;
+        }
+
+        len = page_head & 0xFFFF;
+        if (len > PAGE_DATA_SIZE) {
+            len = PAGE_DATA_SIZE;
+        }
+        if (len > size) {
+            len = size;
+        }
+        if (elog_flash_port_read(PAGE_ADDR(iter->sector, iter->page) + PAGE_HEAD_SIZE, buf, len)
+                != ELOG_FLASH_NO_ERR) {
+            return 0;
+        }
+        iter->page++;
+        return len;
+    }
+
+    return 0;
+}
+
+/**
+ * check the page is erased or not
+ *
+ * @param sector sector index
+ * @param page page index
+ *
+ * @return true: the page is erased
+ */
+static bool page_is_erased(size_t sector, size_t page) {
+    uint32_t page_head = 0;
+
+    elog_flash_port_read(PAGE_ADDR(sector, page), &page_head, sizeof(page_head));
+
+    return page_head == ERASED_WORD;
+}
+
+/**
+ * erase the sector and write the sector head, then it will be the newest sector
+ *
+ * @param sector sector index
+ * @param seq sequence number
+ *
+ * @return result
+ */
+static ElogFlashErrCode start_sector(size_t sector, uint32_t seq) {
+    ElogFlashErrCode result;
+    uint32_t head[SECTOR_HEAD_SIZE / 4] = { SECTOR_MAGIC, seq };
+
+    result = elog_flash_port_erase(SECTOR_ADDR(sector), ELOG_FLASH_SECTOR_SIZE);
+    if (result == ELOG_FLASH_NO_ERR) {
+        result = elog_flash_port_write(SECTOR_ADDR(sector), head, sizeof(head));
+    }
+    if (result == ELOG_FLASH_NO_ERR) {
+        cur_sector = sector;
+        cur_seq = seq;
+        cur_page = 0;
+    }
+
+    return result;
+}
+
+/**
+ * write the page buffer to flash. the newest sector will be changed when it is full.
+ *
+ * @return result
+ */
+static ElogFlashErrCode write_page(void) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    /* the newest sector is full, so the oldest sector will be reused */
+    if (cur_page >= SECTOR_PAGE_NUM) {
+        result = start_sector((cur_sector + 1) % ELOG_FLASH_SECTOR_NUM, cur_seq + 1);
+    }
+    if (result == ELOG_FLASH_NO_ERR) {
+        /* the unused space is filled by erased value */
+        memset((char *) page_buf + PAGE_HEAD_SIZE + page_len, 0xFF, PAGE_DATA_SIZE - page_len);
+        page_buf[0] = ((uint32_t) PAGE_MAGIC << 16) | page_len;
+        result = elog_flash_port_write(PAGE_ADDR(cur_sector, cur_page), page_buf, ELOG_FLASH_PAGE_SIZE);
+        /* the page can't be written again even if it failed */
+        cur_page++;
+    }
+    /* the logs will be dropped when failed */
+    page_len = 0;
+
+    return result;
+}
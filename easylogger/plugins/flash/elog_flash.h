@@ -0,0 +1,75 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: It is an head file for flash log plugin. You can see all be called functions.
+ * Created on: 2026-10-19
+ */
+
+#ifndef __ELOG_FLASH_H__
+#define __ELOG_FLASH_H__
+
+#include "elog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* flash log area start address */
+#define ELOG_FLASH_START_ADDR                0x08070000
+/* flash erase minimum unit, the log area is made up by these sectors. it is 2K on STM32F103xE */
+#define ELOG_FLASH_SECTOR_SIZE               2048
+/* flash log area sector number, the log area size is ELOG_FLASH_SECTOR_SIZE * ELOG_FLASH_SECTOR_NUM */
+#define ELOG_FLASH_SECTOR_NUM                16
+/* the logs will be cached to RAM until a page is full, then it will be written to flash by one time */
+#define ELOG_FLASH_PAGE_SIZE                 256
+/* flash log plugin version number */
+#define ELOG_FLASH_SW_VERSION                "0.10.19"
+
+/* flash log plugin error code */
+typedef enum {
+    ELOG_FLASH_NO_ERR,
+    ELOG_FLASH_READ_ERR,
+    ELOG_FLASH_WRITE_ERR,
+    ELOG_FLASH_ERASE_ERR,
+} ElogFlashErrCode;
+
+/* flash log read back iterator */
+typedef struct {
+    size_t sector;
+    size_t page;
+    size_t read_sectors;
+} ElogFlashIter, *ElogFlashIter_t;
+
+/* elog_flash.c */
+ElogFlashErrCode elog_flash_init(void);
+void elog_flash_write(const char *log, size_t size);
+ElogFlashErrCode elog_flash_flush(void);
+ElogFlashErrCode elog_flash_clean(void);
+void elog_flash_iter_init(ElogFlashIter_t iter);
+size_t elog_flash_iter_next(ElogFlashIter_t iter, char *buf, size_t size);
+
+/* elog_flash_port.c */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, void *buf, size_t size);
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr, size_t size);
+ElogFlashErrCode elog_flash_port_write(uint32_t addr, const uint32_t *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_FLASH_H__ */
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Portable interface for flash log plugin.
+ * Created on: 2026-10-19
+ */
+
+#include "elog_flash.h"
+
+/**
+ * read data from flash
+ *
+ * @param addr flash address
+ * @param buf buffer to store read data
+ * @param size read bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_read(uint32_t addr, void *buf, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    //add your code here
+
+    return result;
+}
+
+/**
+ * Erase flash. The start address and size are aligned by ELOG_FLASH_SECTOR_SIZE.
+ *
+ * @param addr flash address
+ * @param size erase bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_erase(uint32_t addr, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    //add your code here
+
+    return result;
+}
+
+/**
+ * Write data to flash. The start address and size are aligned by 4 bytes.
+ *
+ * @param addr flash address
+ * @param buf the write data buffer
+ * @param size write bytes size
+ *
+ * @return result
+ */
+ElogFlashErrCode elog_flash_port_write(uint32_t addr, const uint32_t *buf, size_t size) {
+    ElogFlashErrCode result = ELOG_FLASH_NO_ERR;
+
+    //add your code here
+
+    return result;
+}
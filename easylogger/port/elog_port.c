@@ -44,6 +44,7 @@ void elog_port_output(const char *output, size_t size) {
 	
 }
 
+#ifndef ELOG_USING_TICKET_LOCK
 /**
  * output lock
  */
@@ -61,6 +62,7 @@ void elog_port_output_unlock(void) {
     //add your code here
 	
 }
+#endif /* ELOG_USING_TICKET_LOCK */
 
 /**
  * get current time interface
@@ -94,3 +96,134 @@ const char *elog_port_get_t_info(void) {
     //add your code here
 	
 }
+
+/**
+ * get current system time in millisecond interface
+ *
+ * @return current millisecond
+ */
+uint32_t elog_port_get_ms(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * check current context is in ISR or not interface
+ *
+ * @return true: in ISR
+ */
+bool elog_port_in_isr(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * disable interrupt interface
+ *
+ * @return the interrupt level before disabled
+ */
+uint32_t elog_port_irq_disable(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * enable interrupt interface
+ *
+ * @param level the interrupt level which is returned by elog_port_irq_disable
+ */
+void elog_port_irq_enable(uint32_t level) {
+	
+    //add your code here
+	
+}
+
+/**
+ * get output backlog interface, it's used by adaptive throttling
+ *
+ * @return the usage percent (0~100) of output buffer or queue, 0: the output isn't buffered
+ */
+uint8_t elog_port_get_backlog(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * get current CPU index interface, it's used by per-CPU log buffer. such as sched_getcpu() on Linux.
+ *
+ * @return CPU index, it must be less than ELOG_PERCPU_CPU_NUM
+ */
+uint8_t elog_port_get_cpu(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * CPU buffer lock interface. it's only contended by the threads on this CPU and the log output.
+ *
+ * @param cpu CPU index
+ */
+void elog_port_cpu_lock(uint8_t cpu) {
+	
+    //add your code here
+	
+}
+
+/**
+ * CPU buffer unlock interface
+ *
+ * @param cpu CPU index
+ */
+void elog_port_cpu_unlock(uint8_t cpu) {
+	
+    //add your code here
+	
+}
+
+/**
+ * get the raw cycle counter interface, such as DWT->CYCCNT on Cortex-M3 or rdtsc on x86.
+ * it's used by cycle counter timestamp, self-latency histogram and timing span.
+ *
+ * @return cycle count
+ */
+uint32_t elog_port_get_cycle(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * get current thread's innermost span interface, it's used by timing span nesting
+ *
+ * @return span, NULL: there is no span in current thread
+ */
+ElogSpan_t elog_port_get_span(void) {
+	
+    //add your code here
+	
+}
+
+/**
+ * set current thread's innermost span interface, it can be saved to thread local storage
+ *
+ * @param span span, NULL: there is no span in current thread
+ */
+void elog_port_set_span(ElogSpan_t span) {
+	
+    //add your code here
+	
+}
+
+/**
+ * yield the CPU interface, it's used by the built-in output lock when the lock holder maybe preempted
+ */
+void elog_port_lock_yield(void) {
+	
+    //add your code here
+	
+}
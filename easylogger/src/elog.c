@@ -25,26 +25,16 @@
 #include <stdarg.h>
 #include <stdio.h>
 
-/* output log's filter */
-typedef struct {
-    uint8_t level;
-    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
-    char keyword[ELOG_FILTER_KW_MAX_LEN + 1];
-} ElogFilter, *ElogFilter_t;
-
-/* easy logger */
-typedef struct {
-    ElogFilter filter;
-    size_t enabled_fmt_set;
-    bool output_enabled;
-}EasyLogger, *EasyLogger_t;
-
-/* EasyLogger object */
-static EasyLogger elog;
+/* EasyLogger default logger object */
+static ElogLogger elog;
 /* log buffer */
 static char log_buf[ELOG_BUF_SIZE] = { 0 };
 /* log tag */
 static const char *tag = "ELOG";
+/* the format of preformatted text, it's checked by address, then the text is copied without vsnprintf */
+static const char text_format[] = "%s";
+/* the hook which flushes the logs buffered by output plugin, it's called by elog_flush */
+static void (*flush_hook)(void) = NULL;
 /* level output info */
 static const char *level_output_info[] = {
         "A/",
@@ -54,7 +44,53 @@ static const char *level_output_info[] = {
         "D/",
         "V/",
 };
-static bool get_fmt_enabled(size_t set);
+static bool get_fmt_enabled(ElogLogger_t logger, size_t set);
+static void output_log(ElogLogger_t logger, uint32_t cycle, uint8_t level, const char *tag, const char *file,
+        const char *func, const long line, uint32_t sample, const char *format, va_list args);
+static size_t format_log(ElogLogger_t logger, char *log_buf, size_t buf_size, uint64_t seq, uint32_t cycle,
+        uint8_t level, const char *tag, const char *file, const char *func, const long line, uint32_t sample,
+        const char *format, va_list args, size_t *head_len);
+static void output_buf(ElogLogger_t logger, uint8_t level, const char *file, const long line, const char *log_buf,
+        size_t log_len, size_t head_len);
+static size_t buf_strcpy(char *log_buf, size_t buf_size, size_t log_len, const char *src);
+#if defined(ELOG_USING_RATE_LIMIT) || defined(ELOG_USING_ISR) || defined(ELOG_USING_THROTTLE) \
+        || defined(ELOG_USING_PERCPU)
+static void output_log_fmt(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...);
+#endif
+#ifdef ELOG_USING_ISR
+static void output_isr_logs(void);
+#endif
+static void output(ElogLogger_t logger, uint8_t level, const char *tag, const uint32_t *tag_hash,
+        const char *file, const char *func, const long line, const char *format, va_list args);
+static void output_text(uint8_t level, const char *tag, const uint32_t *tag_hash, const char *file,
+        const char *func, const long line, const char *format, ...);
+static void output_dispatch(ElogLogger_t logger, uint32_t cycle, uint8_t level, const char *tag,
+        const uint32_t *tag_hash, const char *file, const char *func, const long line, const char *format,
+        va_list args);
+#ifdef ELOG_USING_ISR
+static void isr_output(uint8_t level, const char *tag, const uint32_t *tag_hash, const char *file,
+        const char *func, const long line, const char *format, va_list args);
+#endif
+static bool output_filter(ElogLogger_t logger, uint8_t level, const char *tag, const uint32_t *tag_hash,
+        bool in_isr);
+#ifdef ELOG_USING_RATE_LIMIT
+static void output_rate_evicted(void);
+#endif
+#ifdef ELOG_USING_THROTTLE
+static void output_throttle_transition(size_t dropped);
+#endif
+#ifdef ELOG_USING_PERCPU
+static void percpu_output(uint32_t cycle, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, va_list args);
+static void output_percpu_logs(void);
+#endif
+#ifdef ELOG_USING_CYCLE
+static void output_cycle_calib(void);
+#endif
+#ifdef ELOG_USING_LATENCY
+static void latency_port_output(const char *log, size_t size);
+#endif
 
 /**
  * EasyLogger initialize.
@@ -66,10 +102,18 @@ ElogErrCode elog_init(void) {
 
     /* port initialize */
     result = elog_port_init();
-    /* set level is ELOG_LVL_VERBOSE */
-    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
-    /* enable output */
-    elog_set_output_enabled(true);
+#ifdef ELOG_USING_CRASH_LOG
+    /* replay the last boot's logs and start to record this boot's logs */
+    elog_crash_log_init();
+#endif
+    /* the default logger outputs by port, the level is ELOG_LVL_VERBOSE and output is enabled */
+#ifdef ELOG_USING_LATENCY
+    elog_logger_init(&elog, log_buf, ELOG_BUF_SIZE, latency_port_output, elog_port_output_lock,
+            elog_port_output_unlock);
+#else
+    elog_logger_init(&elog, log_buf, ELOG_BUF_SIZE, elog_port_output, elog_port_output_lock,
+            elog_port_output_unlock);
+#endif
 
     if (result == ELOG_NO_ERR) {
         elog_d(tag, "EasyLogger V%s is initialize success.", ELOG_SW_VERSION);
@@ -85,9 +129,7 @@ ElogErrCode elog_init(void) {
  * @param enabled TRUE: enable FALSE: disable
  */
 void elog_set_output_enabled(bool enabled) {
-    ELOG_ASSERT((enabled == false) || (enabled == true));
-
-    elog.output_enabled = enabled;
+    elog_logger_set_output_enabled(&elog, enabled);
 }
 
 /**
@@ -96,7 +138,7 @@ void elog_set_output_enabled(bool enabled) {
  * @return enable or disable
  */
 bool elog_get_output_enabled(void) {
-    return elog.output_enabled;
+    return elog_logger_get_output_enabled(&elog);
 }
 
 /**
@@ -105,7 +147,7 @@ bool elog_get_output_enabled(void) {
  * @param set format set
  */
 void elog_set_fmt(size_t set) {
-    elog.enabled_fmt_set = set;
+    elog_logger_set_fmt(&elog, set);
 }
 
 /**
@@ -116,11 +158,7 @@ void elog_set_fmt(size_t set) {
  * @param keyword keyword
  */
 void elog_set_filter(uint8_t level, const char *tag, const char *keyword) {
-    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
-
-    elog_set_filter_lvl(level);
-    elog_set_filter_tag(tag);
-    elog_set_filter_kw(keyword);
+    elog_logger_set_filter(&elog, level, tag, keyword);
 }
 
 /**
@@ -129,9 +167,16 @@ void elog_set_filter(uint8_t level, const char *tag, const char *keyword) {
  * @param level level
  */
 void elog_set_filter_lvl(uint8_t level) {
-    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    elog_logger_set_filter_lvl(&elog, level);
+}
 
-    elog.filter.level = level;
+/**
+ * get log filter's level
+ *
+ * @return level
+ */
+uint8_t elog_get_filter_lvl(void) {
+    return elog_logger_get_filter_lvl(&elog);
 }
 
 /**
@@ -140,7 +185,7 @@ void elog_set_filter_lvl(uint8_t level) {
  * @param tag tag
  */
 void elog_set_filter_tag(const char *tag) {
-    strncpy(elog.filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    elog_logger_set_filter_tag(&elog, tag);
 }
 
 /**
@@ -149,7 +194,143 @@ void elog_set_filter_tag(const char *tag) {
  * @param keyword keyword
  */
 void elog_set_filter_kw(const char *keyword) {
-    strncpy(elog.filter.keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
+    elog_logger_set_filter_kw(&elog, keyword);
+}
+
+/**
+ * get the default logger, the elog_xxx API without logger parameter are working on it
+ *
+ * @return default logger
+ */
+ElogLogger_t elog_get_logger(void) {
+    return &elog;
+}
+
+/**
+ * Initialize a logger. Each logger has it's own filter, format, buffer, lock and output, so the
+ * subsystems can output log to different output without contending on the same lock.
+ * The rate limit, sampling, ISR log and other extended features only work on the default logger.
+ * After initialized, the level is ELOG_LVL_VERBOSE, the output is enabled and no format is enabled.
+ *
+ * @param logger logger
+ * @param buf log buffer, the log longer than it will be truncated
+ * @param size log buffer size
+ * @param output output function
+ * @param lock lock function, NULL: the logger is only used by one thread
+ * @param unlock unlock function, NULL: the logger is only used by one thread
+ */
+void elog_logger_init(ElogLogger_t logger, char *buf, size_t size, void (*output)(const char *log, size_t size),
+        void (*lock)(void), void (*unlock)(void)) {
+    ELOG_ASSERT(logger);
+    ELOG_ASSERT(buf);
+    ELOG_ASSERT(size > 2);
+    ELOG_ASSERT(output);
+
+    memset(logger, 0, sizeof(ElogLogger));
+    logger->buf = buf;
+    logger->buf_size = size;
+    logger->output = output;
+    logger->lock = lock;
+    logger->unlock = unlock;
+    logger->filter.level = ELOG_LVL_VERBOSE;
+    logger->output_enabled = true;
+}
+
+/**
+ * set logger output enable or disable
+ *
+ * @param logger logger
+ * @param enabled TRUE: enable FALSE: disable
+ */
+void elog_logger_set_output_enabled(ElogLogger_t logger, bool enabled) {
+    ELOG_ASSERT((enabled == false) || (enabled == true));
+
+    logger->output_enabled = enabled;
+}
+
+/**
+ * get logger output is enable or disable
+ *
+ * @param logger logger
+ *
+ * @return enable or disable
+ */
+bool elog_logger_get_output_enabled(ElogLogger_t logger) {
+    return logger->output_enabled;
+}
+
+/**
+ * set logger output format. only enable or disable
+ *
+ * @param logger logger
+ * @param set format set
+ */
+void elog_logger_set_fmt(ElogLogger_t logger, size_t set) {
+    logger->enabled_fmt_set = set;
+}
+
+/**
+ * set logger filter all parameter
+ *
+ * @param logger logger
+ * @param level level
+ * @param tag tag
+ * @param keyword keyword
+ */
+void elog_logger_set_filter(ElogLogger_t logger, uint8_t level, const char *tag, const char *keyword) {
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    elog_logger_set_filter_lvl(logger, level);
+    elog_logger_set_filter_tag(logger, tag);
+    elog_logger_set_filter_kw(logger, keyword);
+}
+
+/**
+ * set logger filter's level
+ *
+ * @param logger logger
+ * @param level level
+ */
+void elog_logger_set_filter_lvl(ElogLogger_t logger, uint8_t level) {
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    logger->filter.level = level;
+}
+
+/**
+ * get logger filter's level
+ *
+ * @param logger logger
+ *
+ * @return level
+ */
+uint8_t elog_logger_get_filter_lvl(ElogLogger_t logger) {
+    return logger->filter.level;
+}
+
+/**
+ * set logger filter's tag
+ *
+ * @param logger logger
+ * @param tag tag
+ */
+void elog_logger_set_filter_tag(ElogLogger_t logger, const char *tag) {
+    strncpy(logger->filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+#ifdef ELOG_USING_TAG_TABLE
+    if (logger == &elog) {
+        elog_tag_filter_changed();
+    }
+#endif
+}
+
+/**
+ * set logger filter's keyword
+ *
+ * @param logger logger
+ * @param keyword keyword
+ */
+void elog_logger_set_filter_kw(ElogLogger_t logger, const char *keyword) {
+    strncpy(logger->filter.keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
 }
 
 /**
@@ -191,6 +372,44 @@ void elog_raw(const char *format, ...) {
     va_end(args);
 }
 
+/**
+ * Flush the pending log which is hold by EasyLogger, such as the repeated log counter.
+ * It can be called periodically by user, then the pending log won't be delayed too long.
+ */
+void elog_flush(void) {
+    /* lock output */
+    elog_port_output_lock();
+
+#ifdef ELOG_USING_ISR
+    output_isr_logs();
+#endif
+
+#ifdef ELOG_USING_PERCPU
+    output_percpu_logs();
+#endif
+
+#ifdef ELOG_USING_COALESCE
+    elog_coalesce_flush();
+#endif
+
+    if (flush_hook) {
+        flush_hook();
+    }
+
+    /* unlock output */
+    elog_port_output_unlock();
+}
+
+/**
+ * Set the hook which flushes the logs buffered by output plugin, such as the file buffer.
+ * It's called by elog_flush with the output lock held.
+ *
+ * @param hook flush hook, NULL: remove the hook
+ */
+void elog_set_flush_hook(void (*hook)(void)) {
+    flush_hook = hook;
+}
+
 /**
  * output the log
  *
@@ -205,12 +424,192 @@ void elog_raw(const char *format, ...) {
  */
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...) {
-    size_t tag_len = strlen(tag), log_len = 0;
-    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
-    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
     va_list args;
-    int fmt_result;
 
+    /* args point to the first variable parameter */
+    va_start(args, format);
+
+    output(&elog, level, tag, NULL, file, func, line, format, args);
+
+    va_end(args);
+}
+
+/**
+ * output the log by logger
+ *
+ * @param logger logger
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ */
+void elog_logger_output(ElogLogger_t logger, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    va_list args;
+
+    ELOG_ASSERT(logger);
+
+    /* args point to the first variable parameter */
+    va_start(args, format);
+
+    output(logger, level, tag, NULL, file, func, line, format, args);
+
+    va_end(args);
+}
+
+/**
+ * Output the log which tag hash value has been calculated, such as the C++ tag in elog.hpp
+ * which is hashed at compile time. The tag needn't be hashed when it's interned to tag table.
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, it's calculated by elog_hash(ELOG_HASH_INIT, tag, strlen(tag))
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ */
+void elog_output_hash(uint8_t level, const char *tag, uint32_t tag_hash, const char *file,
+        const char *func, const long line, const char *format, ...) {
+    va_list args;
+
+    /* args point to the first variable parameter */
+    va_start(args, format);
+
+    output(&elog, level, tag, &tag_hash, file, func, line, format, args);
+
+    va_end(args);
+}
+
+/**
+ * Output the preformatted text, such as the log which is formatted by elog.hpp type safe API.
+ * The text isn't parsed as format string, it's copied to log buffer directly.
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param str preformatted text
+ */
+void elog_output_str(uint8_t level, const char *tag, const uint32_t *tag_hash, const char *file,
+        const char *func, const long line, const char *str) {
+    output_text(level, tag, tag_hash, file, func, line, text_format, str);
+}
+
+/**
+ * output the preformatted text by text_format, the variable parameter is the text
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format it's text_format
+ * @param ... text
+ */
+static void output_text(uint8_t level, const char *tag, const uint32_t *tag_hash, const char *file,
+        const char *func, const long line, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+
+    output(&elog, level, tag, tag_hash, file, func, line, format, args);
+
+    va_end(args);
+}
+
+/**
+ * Check the log will be output or not, then the log which is filtered needn't be formatted.
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ *
+ * @return true: the log will be output
+ */
+bool elog_output_check(uint8_t level, const char *tag, const uint32_t *tag_hash) {
+    bool in_isr = false;
+
+    if (!elog.output_enabled) {
+        return false;
+    }
+#ifdef ELOG_USING_ISR
+    in_isr = elog_port_in_isr();
+#endif
+
+    return output_filter(&elog, level, tag, tag_hash, in_isr);
+}
+
+#ifdef ELOG_USING_ISR
+/**
+ * Output the log in ISR. The log is saved to ISR log buffer without lock,
+ * and it will be output in thread context by next log output or elog_flush.
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ */
+void elog_isr_output(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    va_list args;
+
+    /* args point to the first variable parameter */
+    va_start(args, format);
+
+    isr_output(level, tag, NULL, file, func, line, format, args);
+
+    va_end(args);
+}
+
+/**
+ * output the log in ISR which tag hash value has been calculated
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, it's calculated by elog_hash(ELOG_HASH_INIT, tag, strlen(tag))
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ */
+void elog_isr_output_hash(uint8_t level, const char *tag, uint32_t tag_hash, const char *file,
+        const char *func, const long line, const char *format, ...) {
+    va_list args;
+
+    /* args point to the first variable parameter */
+    va_start(args, format);
+
+    isr_output(level, tag, &tag_hash, file, func, line, format, args);
+
+    va_end(args);
+}
+
+/**
+ * save the log in ISR to ISR log buffer
+ *
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+static void isr_output(uint8_t level, const char *tag, const uint32_t *tag_hash, const char *file,
+        const char *func, const long line, const char *format, va_list args) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
     /* check output enabled */
@@ -218,130 +617,681 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         return;
     }
 
-    /* level filter */
-    if (level > elog.filter.level) {
+    /* level and tag filter */
+    if (!output_filter(&elog, level, tag, tag_hash, true)) {
         return;
-    } else if (!strstr(tag, elog.filter.tag)) { /* tag filter */
-        //TODO ԿǲKMPģʽƥַ
+    }
+
+    elog_isr_write(level, tag, file, func, line, format, args);
+}
+
+/**
+ * output all logs in ISR log buffer. the caller must hold the output lock.
+ */
+static void output_isr_logs(void) {
+    static const char * const lane_info[] = { "assert/error", "warn/info", "debug/verbose" };
+    ElogIsrLog_t isr_log;
+    size_t dropped, i;
+
+    /* the higher priority lane is output first */
+    while ((isr_log = elog_isr_read()) != NULL) {
+        output_log_fmt(isr_log->level, isr_log->tag, isr_log->file, isr_log->func, isr_log->line,
+                "[ISR %lu] %s", (unsigned long) isr_log->ms, isr_log->log);
+        elog_isr_release();
+    }
+    for (i = 0; i < ELOG_ISR_LANE_NUM; i++) {
+        if ((dropped = elog_isr_get_dropped(i)) != 0) {
+            output_log_fmt(i == 0 ? ELOG_LVL_ERROR : ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__,
+                    "%lu %s ISR logs dropped", (unsigned long) dropped, lane_info[i]);
+        }
+    }
+}
+#endif /* ELOG_USING_ISR */
+
+/**
+ * filter, package and output the log, the latency of it is measured when ELOG_USING_LATENCY is enabled
+ *
+ * @param logger logger
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+static void output(ElogLogger_t logger, uint8_t level, const char *tag, const uint32_t *tag_hash,
+        const char *file, const char *func, const long line, const char *format, va_list args) {
+#if defined(ELOG_USING_CYCLE) || defined(ELOG_USING_LATENCY)
+    /* the cycle count is taken at call time */
+    uint32_t cycle = elog_port_get_cycle();
+#else
+    uint32_t cycle = 0;
+#endif
+
+    output_dispatch(logger, cycle, level, tag, tag_hash, file, func, line, format, args);
+
+#ifdef ELOG_USING_LATENCY
+    elog_latency_record(ELOG_LATENCY_CALL, elog_port_get_cycle() - cycle);
+#endif
+}
+
+/**
+ * filter and dispatch the log to output, ISR buffer or per-CPU buffer
+ *
+ * @param logger logger
+ * @param cycle the cycle count at call time
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+static void output_dispatch(ElogLogger_t logger, uint32_t cycle, uint8_t level, const char *tag,
+        const uint32_t *tag_hash, const char *file, const char *func, const long line, const char *format,
+        va_list args) {
+    uint32_t sample = 1;
+#ifdef ELOG_USING_RATE_LIMIT
+    size_t suppressed;
+    bool rate_ok;
+#endif
+#ifdef ELOG_USING_THROTTLE
+    size_t dropped;
+#endif
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    /* check output enabled */
+    if (!logger->output_enabled) {
         return;
     }
 
-    /* args point to the first variable parameter */
-    va_start(args, format);
+    /* the other logger only has filter and format, the extended features work on default logger */
+    if (logger != &elog) {
+        if (output_filter(logger, level, tag, tag_hash, false)) {
+            if (logger->lock) {
+                logger->lock();
+            }
+            output_log(logger, cycle, level, tag, file, func, line, 1, format, args);
+            if (logger->unlock) {
+                logger->unlock();
+            }
+        }
+        return;
+    }
+
+#ifdef ELOG_USING_ISR
+    /* the log in ISR will be output in thread context */
+    if (elog_port_in_isr()) {
+        isr_output(level, tag, tag_hash, file, func, line, format, args);
+        return;
+    }
+#endif
+
+    /* level and tag filter */
+    if (!output_filter(&elog, level, tag, tag_hash, false)) {
+        return;
+    }
+
+#ifdef ELOG_USING_PERCPU
+    /* The log is saved to current CPU's buffer without output lock, it will be output by elog_flush.
+     * The assert and error log is output at once, it mustn't be lost when the system halts after it. */
+    if (level > ELOG_LVL_ERROR) {
+        percpu_output(cycle, level, tag, file, func, line, format, args);
+        return;
+    }
+#endif
 
     /* lock output */
     elog_port_output_lock();
+
+#ifdef ELOG_USING_ISR
+    /* the ISR logs are earlier than this log */
+    output_isr_logs();
+#endif
+
+#ifdef ELOG_USING_PERCPU
+    /* the buffered logs are earlier than this log */
+    output_percpu_logs();
+#endif
+
+#ifdef ELOG_USING_THROTTLE
+    /* the output level is limited when the output backlog is high, the level transition is logged */
+    if (elog_throttle_update(&dropped)) {
+        output_throttle_transition(dropped);
+    }
+    if (!elog_throttle_check(level)) {
+        elog_port_output_unlock();
+        return;
+    }
+#endif
+
+#ifdef ELOG_USING_SAMPLE
+    /* sampling for this tag or call site, it must be checked before the log is formatted */
+    if (!elog_sample_check(tag, file, line, &sample)) {
+        elog_port_output_unlock();
+        return;
+    }
+#endif
+
+#ifdef ELOG_USING_RATE_LIMIT
+    /* rate limit for this call site, it must be checked before the log is formatted */
+    rate_ok = elog_rate_limit_check(level, file, line, &suppressed);
+    output_rate_evicted();
+    if (!rate_ok) {
+        elog_port_output_unlock();
+        return;
+    } else if (suppressed) {
+        output_log_fmt(level, tag, file, func, line, "%lu messages suppressed", (unsigned long) suppressed);
+    }
+#endif /* ELOG_USING_RATE_LIMIT */
+
+    output_log(&elog, cycle, level, tag, file, func, line, sample, format, args);
+
+    /* unlock output */
+    elog_port_output_unlock();
+}
+
+#ifdef ELOG_USING_RATE_LIMIT
+/**
+ * Output the suppressed log number of the evicted call site by library tag, it won't be reported by
+ * the call site because it's bucket has been reused. The caller must hold the output lock.
+ */
+static void output_rate_evicted(void) {
+    const char *file;
+    long line;
+    size_t suppressed = elog_rate_limit_get_evicted(&file, &line);
+
+    if (suppressed) {
+        output_log_fmt(ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__, "%lu messages suppressed at %s:%ld",
+                (unsigned long) suppressed, file, line);
+    }
+}
+#endif /* ELOG_USING_RATE_LIMIT */
+
+#ifdef ELOG_USING_THROTTLE
+/**
+ * output the throttle level transition by library tag. the caller must hold the output lock.
+ *
+ * @param dropped the dropped log number by last throttle level
+ */
+static void output_throttle_transition(size_t dropped) {
+    if (elog_throttle_get_lvl() == ELOG_LVL_VERBOSE) {
+        output_log_fmt(ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__,
+                "output throttle is off, %lu logs dropped", (unsigned long) dropped);
+    } else {
+        output_log_fmt(ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__,
+                "output throttle level is %c, %lu logs dropped", level_output_info[elog_throttle_get_lvl()][0],
+                (unsigned long) dropped);
+    }
+}
+#endif /* ELOG_USING_THROTTLE */
+
+#ifdef ELOG_USING_PERCPU
+/**
+ * package the log to current CPU's buffer with the CPU lock
+ *
+ * @param cycle the cycle count at call time
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+static void percpu_output(uint32_t cycle, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, va_list args) {
+    uint8_t cpu = elog_port_get_cpu();
+    uint64_t seq;
+    ElogCpuLog_t cpu_log;
+
+    ELOG_ASSERT(cpu < ELOG_PERCPU_CPU_NUM);
+
+    elog_port_cpu_lock(cpu);
+    /* The sequence number is taken in the CPU lock, so the logs in each CPU's buffer are in sequence order.
+     * It's taken before allocation, so the dropped log can be found by the gap. */
+    seq = elog_seq_next();
+    if ((cpu_log = elog_percpu_alloc(cpu)) != NULL) {
+        cpu_log->len = format_log(&elog, cpu_log->log, ELOG_PERCPU_LOG_MAX_LEN, seq, cycle, level, tag, file, func,
+                line, 1, format, args, &cpu_log->head_len);
+        /* the log which is filtered by keyword isn't committed */
+        if (cpu_log->len) {
+            cpu_log->seq = seq;
+            cpu_log->level = level;
+            cpu_log->file = file;
+            cpu_log->line = line;
+            elog_percpu_commit(cpu);
+        }
+    }
+    elog_port_cpu_unlock(cpu);
+}
+
+/**
+ * merge all CPUs' logs by sequence number and output them. the caller must hold the output lock.
+ */
+static void output_percpu_logs(void) {
+    ElogCpuLog_t cpu_log;
+    size_t dropped;
+    uint8_t cpu;
+
+    elog_percpu_begin();
+    while ((cpu_log = elog_percpu_read()) != NULL) {
+        output_buf(&elog, cpu_log->level, cpu_log->file, cpu_log->line, cpu_log->log, cpu_log->len,
+                cpu_log->head_len);
+        elog_percpu_release();
+    }
+    elog_percpu_end();
+    for (cpu = 0; cpu < ELOG_PERCPU_CPU_NUM; cpu++) {
+        if ((dropped = elog_percpu_get_dropped(cpu)) != 0) {
+            output_log_fmt(ELOG_LVL_WARN, tag, ELOG_FILE, __FUNCTION__, __LINE__, "%lu logs dropped on CPU %u",
+                    (unsigned long) dropped, cpu);
+        }
+    }
+}
+#endif /* ELOG_USING_PERCPU */
+
+/**
+ * Check the log can be output or not by level filter and tag filter.
+ * The interned tag is checked by tag table, so it needn't string compare.
+ *
+ * @param logger logger, only the default logger uses tag table
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param in_isr true: it's called in ISR, the tag won't be interned
+ *
+ * @return true: the log can be output
+ */
+static bool output_filter(ElogLogger_t logger, uint8_t level, const char *tag, const uint32_t *tag_hash,
+        bool in_isr) {
+#ifdef ELOG_USING_TAG_TABLE
+    uint8_t id;
+
+    if (logger == &elog) {
+        id = in_isr ? elog_tag_find_id(tag, tag_hash) : elog_tag_get_id(tag, tag_hash);
+        if (id != ELOG_TAG_ID_INVALID) {
+            return elog_tag_check(id, level, elog.filter.level, elog.filter.tag);
+        }
+    }
+#else
+    (void) tag_hash;
+    (void) in_isr;
+#endif
+
+    /* level filter */
+    if (level > logger->filter.level) {
+        return false;
+    } else if (!strstr(tag, logger->filter.tag)) { /* tag filter */
+        //TODO ԿǲKMPģʽƥַ
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * package the log to buffer and output it. the caller must hold the logger lock.
+ *
+ * @param logger logger
+ * @param cycle the cycle count at call time
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param sample the log number which is represented by this sampled log, 1: the log isn't sampled
+ * @param format output format
+ * @param args args
+ */
+static void output_log(ElogLogger_t logger, uint32_t cycle, uint8_t level, const char *tag, const char *file,
+        const char *func, const long line, uint32_t sample, const char *format, va_list args) {
+    size_t log_len, head_len;
+    uint64_t seq = get_fmt_enabled(logger, ELOG_FMT_SEQ) ? elog_seq_next() : 0;
+
+    log_len = format_log(logger, logger->buf, logger->buf_size, seq, cycle, level, tag, file, func, line, sample,
+            format, args, &head_len);
+    if (log_len) {
+        output_buf(logger, level, file, line, logger->buf, log_len, head_len);
+    }
+}
+
+/**
+ * package the log to buffer by logger's format and keyword filter
+ *
+ * @param logger logger
+ * @param log_buf log buffer
+ * @param buf_size log buffer size
+ * @param seq global sequence number, it's output when ELOG_FMT_SEQ is enabled
+ * @param cycle the cycle count at call time, it's output when ELOG_FMT_CYCLE is enabled
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param sample the log number which is represented by this sampled log, 1: the log isn't sampled
+ * @param format output format
+ * @param args args
+ * @param head_len the header info length of the log
+ *
+ * @return log length, 0: the log is filtered by keyword
+ */
+static size_t format_log(ElogLogger_t logger, char *log_buf, size_t buf_size, uint64_t seq, uint32_t cycle,
+        uint8_t level, const char *tag, const char *file, const char *func, const long line, uint32_t sample,
+        const char *format, va_list args, size_t *head_len) {
+    size_t tag_len = strlen(tag), log_len = 0;
+    char seq_num[22], *seq_start = &seq_num[sizeof(seq_num) - 1];
+#ifdef ELOG_USING_CYCLE
+    char cycle_num[] = "@00000000 ";
+    size_t i;
+#else
+    (void) cycle;
+#endif
+    char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
+    char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
+    const char *text;
+    size_t text_len, copy_len;
+    int fmt_result;
+
+    /* package sequence number, the 64 bits integer isn't supported by some printf */
+    if (get_fmt_enabled(logger, ELOG_FMT_SEQ)) {
+        *seq_start = '\0';
+        do {
+            *--seq_start = (char) ('0' + seq % 10);
+            seq /= 10;
+        } while (seq);
+        *--seq_start = '#';
+        log_len += buf_strcpy(log_buf, buf_size, log_len, seq_start);
+        log_len += buf_strcpy(log_buf, buf_size, log_len, " ");
+    }
+#ifdef ELOG_USING_CYCLE
+    /* package cycle count by fixed width hex, it's converted to time by tools/elog_cycle.py */
+    if (get_fmt_enabled(logger, ELOG_FMT_CYCLE)) {
+        for (i = 8; i > 0; i--, cycle >>= 4) {
+            cycle_num[i] = "0123456789abcdef"[cycle & 0x0F];
+        }
+        log_len += buf_strcpy(log_buf, buf_size, log_len, cycle_num);
+    }
+#endif
     /* package level info */
-    if (get_fmt_enabled(ELOG_FMT_LVL)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, level_output_info[level]);
+    if (get_fmt_enabled(logger, ELOG_FMT_LVL)) {
+        log_len += buf_strcpy(log_buf, buf_size, log_len, level_output_info[level]);
     }
     /* package tag info */
-    if (get_fmt_enabled(ELOG_FMT_TAG)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, tag);
+    if (get_fmt_enabled(logger, ELOG_FMT_TAG)) {
+        log_len += buf_strcpy(log_buf, buf_size, log_len, tag);
         /* if the tag length is less than 50% ELOG_FILTER_TAG_MAX_LEN, then fill space */
         if (tag_len <= ELOG_FILTER_TAG_MAX_LEN / 2) {
             memset(tag_sapce, ' ', ELOG_FILTER_TAG_MAX_LEN / 2 - tag_len);
-            log_len += elog_strcpy(log_len, log_buf + log_len, tag_sapce);
+            log_len += buf_strcpy(log_buf, buf_size, log_len, tag_sapce);
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+        log_len += buf_strcpy(log_buf, buf_size, log_len, " ");
     }
     /* package time, process and thread info */
-    if (get_fmt_enabled(ELOG_FMT_TIME) || get_fmt_enabled(ELOG_FMT_P_INFO)
-            || get_fmt_enabled(ELOG_FMT_T_INFO)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, "[");
+    if (get_fmt_enabled(logger, ELOG_FMT_TIME) || get_fmt_enabled(logger, ELOG_FMT_P_INFO)
+            || get_fmt_enabled(logger, ELOG_FMT_T_INFO)) {
+        log_len += buf_strcpy(log_buf, buf_size, log_len, "[");
         /* package time info */
-        if (get_fmt_enabled(ELOG_FMT_TIME)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_time());
-            if (get_fmt_enabled(ELOG_FMT_P_INFO) || get_fmt_enabled(ELOG_FMT_T_INFO)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+        if (get_fmt_enabled(logger, ELOG_FMT_TIME)) {
+            log_len += buf_strcpy(log_buf, buf_size, log_len, elog_port_get_time());
+            if (get_fmt_enabled(logger, ELOG_FMT_P_INFO) || get_fmt_enabled(logger, ELOG_FMT_T_INFO)) {
+                log_len += buf_strcpy(log_buf, buf_size, log_len, " ");
             }
         }
         /* package process info */
-        if (get_fmt_enabled(ELOG_FMT_P_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_p_info());
-            if (get_fmt_enabled(ELOG_FMT_T_INFO)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+        if (get_fmt_enabled(logger, ELOG_FMT_P_INFO)) {
+            log_len += buf_strcpy(log_buf, buf_size, log_len, elog_port_get_p_info());
+            if (get_fmt_enabled(logger, ELOG_FMT_T_INFO)) {
+                log_len += buf_strcpy(log_buf, buf_size, log_len, " ");
             }
         }
         /* package thread info */
-        if (get_fmt_enabled(ELOG_FMT_T_INFO)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_t_info());
+        if (get_fmt_enabled(logger, ELOG_FMT_T_INFO)) {
+            log_len += buf_strcpy(log_buf, buf_size, log_len, elog_port_get_t_info());
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, "] ");
+        log_len += buf_strcpy(log_buf, buf_size, log_len, "] ");
     }
     /* package file directory and name, function name and line number info */
-    if (get_fmt_enabled(ELOG_FMT_DIR) || get_fmt_enabled(ELOG_FMT_FUNC)
-            || get_fmt_enabled(ELOG_FMT_LINE)) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, "(");
+    if (get_fmt_enabled(logger, ELOG_FMT_DIR) || get_fmt_enabled(logger, ELOG_FMT_FUNC)
+            || get_fmt_enabled(logger, ELOG_FMT_LINE)) {
+        log_len += buf_strcpy(log_buf, buf_size, log_len, "(");
         /* package time info */
-        if (get_fmt_enabled(ELOG_FMT_DIR)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, file);
-            if (get_fmt_enabled(ELOG_FMT_FUNC)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
-            } else if (get_fmt_enabled(ELOG_FMT_LINE)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, ":");
+        if (get_fmt_enabled(logger, ELOG_FMT_DIR)) {
+            log_len += buf_strcpy(log_buf, buf_size, log_len, file);
+            if (get_fmt_enabled(logger, ELOG_FMT_FUNC)) {
+                log_len += buf_strcpy(log_buf, buf_size, log_len, " ");
+            } else if (get_fmt_enabled(logger, ELOG_FMT_LINE)) {
+                log_len += buf_strcpy(log_buf, buf_size, log_len, ":");
             }
         }
         /* package process info */
-        if (get_fmt_enabled(ELOG_FMT_FUNC)) {
-            log_len += elog_strcpy(log_len, log_buf + log_len, func);
-            if (get_fmt_enabled(ELOG_FMT_LINE)) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, ":");
+        if (get_fmt_enabled(logger, ELOG_FMT_FUNC)) {
+            log_len += buf_strcpy(log_buf, buf_size, log_len, func);
+            if (get_fmt_enabled(logger, ELOG_FMT_LINE)) {
+                log_len += buf_strcpy(log_buf, buf_size, log_len, ":");
             }
         }
         /* package thread info */
-        if (get_fmt_enabled(ELOG_FMT_LINE)) {
+        if (get_fmt_enabled(logger, ELOG_FMT_LINE)) {
             //TODO snprintfԴռÿܽϸߣŻ
             snprintf(line_num, ELOG_LINE_NUM_MAX_LEN, "%ld", line);
-            log_len += elog_strcpy(log_len, log_buf + log_len, line_num);
+            log_len += buf_strcpy(log_buf, buf_size, log_len, line_num);
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, ")");
+        log_len += buf_strcpy(log_buf, buf_size, log_len, ")");
     }
 
     /* add space and colon sign */
     if (log_len != 0) {
-        log_len += elog_strcpy(log_len, log_buf + log_len, ": ");
+        log_len += buf_strcpy(log_buf, buf_size, log_len, ": ");
     }
 
-    /* package other log data to buffer. CRLF length is 2. '\0' must be added in the end by vsnprintf. */
-    fmt_result = vsnprintf(log_buf + log_len, ELOG_BUF_SIZE - log_len - 2 + 1, format, args);
+    *head_len = log_len;
 
-    va_end(args);
+    /* package the sample info, it's used for extrapolating the log count. the last 2 bytes are kept for CRLF */
+    if (sample > 1) {
+        fmt_result = snprintf(log_buf + log_len, buf_size - log_len, "[1/%lu] ", (unsigned long) sample);
+        if (fmt_result > 0 && log_len + fmt_result <= buf_size - 2) {
+            log_len += fmt_result;
+        }
+    }
+
+    /* package other log data to buffer. CRLF length is 2. '\0' must be added in the end by vsnprintf. */
+    if (format == text_format) {
+        /* the preformatted text is copied as vsnprintf does, the result is the full text length */
+        text = va_arg(args, const char *);
+        text_len = strlen(text);
+        copy_len = text_len < buf_size - log_len - 2 ? text_len : buf_size - log_len - 2;
+        memcpy(log_buf + log_len, text, copy_len);
+        log_buf[log_len + copy_len] = '\0';
+        fmt_result = (int) text_len;
+    } else {
+        fmt_result = vsnprintf(log_buf + log_len, buf_size - log_len - 2 + 1, format, args);
+    }
 
     /* keyword filter */
-    if (!strstr(log_buf, elog.filter.keyword)) {
+    if (!strstr(log_buf, logger->filter.keyword)) {
         //TODO ԿǲKMPģʽƥַ
-        /* unlock output */
-        elog_port_output_unlock();
-        return;
+        return 0;
     }
 
     /* package CRLF */
-    if ((fmt_result > -1) && (fmt_result + log_len + 2 <= ELOG_BUF_SIZE)) {
+    if ((fmt_result > -1) && (fmt_result + log_len + 2 <= buf_size)) {
         log_len += fmt_result;
         log_len += elog_strcpy(log_len, log_buf + log_len, "\r\n");
 
     } else {
-        log_buf[ELOG_BUF_SIZE - 2] = '\r';
-        log_buf[ELOG_BUF_SIZE - 1] = '\n';
+        log_len = buf_size;
+        log_buf[buf_size - 2] = '\r';
+        log_buf[buf_size - 1] = '\n';
     }
 
+    return log_len;
+}
+
+/**
+ * output the packaged log. the caller must hold the logger lock.
+ *
+ * @param logger logger
+ * @param level level
+ * @param file file name
+ * @param line line number
+ * @param log_buf log buffer
+ * @param log_len log length
+ * @param head_len the header info length of the log
+ */
+static void output_buf(ElogLogger_t logger, uint8_t level, const char *file, const long line, const char *log_buf,
+        size_t log_len, size_t head_len) {
+#ifndef ELOG_USING_FLIGHT_RECORDER
+    (void) level;
+#endif
+#ifndef ELOG_USING_COALESCE
+    (void) file;
+    (void) line;
+    (void) head_len;
+#endif
+
+    /* the extended features only work on default logger */
+    if (logger != &elog) {
+        logger->output(log_buf, log_len);
+        return;
+    }
+
+#ifdef ELOG_USING_CYCLE
+    output_cycle_calib();
+#endif
+
+#ifdef ELOG_USING_CRASH_LOG
+    /* the newest logs are kept in no-init RAM */
+    elog_crash_log_write(log_buf, log_len);
+#endif
+
+#ifdef ELOG_USING_FLIGHT_RECORDER
+    /* all logs are recorded to flight recorder, only the high level logs will be output */
+    elog_flight_write(log_buf, log_len);
+    if (level <= ELOG_FLIGHT_DUMP_LVL) {
+        elog_flight_output(0);
+        return;
+    } else if (level > ELOG_FLIGHT_OUTPUT_LVL) {
+        return;
+    }
+#endif
+
+#ifdef ELOG_USING_COALESCE
+    /* the repeated log will be counted, the header isn't compared because it maybe has time info */
+    if (!elog_coalesce_check(file, line, log_buf + head_len, log_len - head_len)) {
+        return;
+    }
+#endif
+
     /* output log */
-    elog_port_output(log_buf, log_len);
+    logger->output(log_buf, log_len);
+}
 
-    /* unlock output */
-    elog_port_output_unlock();
+#if defined(ELOG_USING_RATE_LIMIT) || defined(ELOG_USING_ISR) || defined(ELOG_USING_THROTTLE) \
+        || defined(ELOG_USING_PERCPU)
+/**
+ * package the log to buffer and output it by variable parameter.
+ * the caller must hold the output lock.
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ */
+static void output_log_fmt(uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+#ifdef ELOG_USING_CYCLE
+    output_log(&elog, elog_port_get_cycle(), level, tag, file, func, line, 1, format, args);
+#else
+    output_log(&elog, 0, level, tag, file, func, line, 1, format, args);
+#endif
+    va_end(args);
+}
+#endif /* defined(ELOG_USING_RATE_LIMIT) || ... || defined(ELOG_USING_PERCPU) */
+
+#ifdef ELOG_USING_CYCLE
+/**
+ * Output the cycle counter calibration point every ELOG_CYCLE_CALIB_INTERVAL. The cycle count in log
+ * is converted to time by the nearby calibration points. the caller must hold the output lock.
+ */
+static void output_cycle_calib(void) {
+    static uint32_t last_ms = 0;
+    static bool started = false;
+    uint32_t ms = elog_port_get_ms();
+    char calib[48];
+    int len;
+
+    if (started && ms - last_ms < ELOG_CYCLE_CALIB_INTERVAL) {
+        return;
+    }
+    last_ms = ms;
+    started = true;
+
+    len = snprintf(calib, sizeof(calib), "[elog calib] cycle=%08lx ms=%lu\r\n",
+            (unsigned long) elog_port_get_cycle(), (unsigned long) ms);
+    if (len > 0 && (size_t) len < sizeof(calib)) {
+        elog_port_output(calib, len);
+    }
+}
+#endif /* ELOG_USING_CYCLE */
+
+#ifdef ELOG_USING_LATENCY
+/**
+ * output the log by port and measure the latency of it
+ *
+ * @param log log
+ * @param size log size
+ */
+static void latency_port_output(const char *log, size_t size) {
+    uint32_t cycle = elog_port_get_cycle();
+
+    elog_port_output(log, size);
+
+    elog_latency_record(ELOG_LATENCY_OUTPUT, elog_port_get_cycle() - cycle);
+}
+#endif /* ELOG_USING_LATENCY */
+
+/**
+ * copy the string to log buffer. the last 2 bytes of buffer are kept for CRLF.
+ *
+ * @param log_buf log buffer
+ * @param buf_size log buffer size
+ * @param log_len current log length
+ * @param src source
+ *
+ * @return copied length
+ */
+static size_t buf_strcpy(char *log_buf, size_t buf_size, size_t log_len, const char *src) {
+    size_t len = 0;
+
+    while (src[len] != 0 && log_len + len < buf_size - 2) {
+        log_buf[log_len + len] = src[len];
+        len++;
+    }
+
+    return len;
 }
 
 /**
  * get format enabled
  *
+ * @param logger logger
  * @param set format set
  *
  * @return enable or disable
  */
-static bool get_fmt_enabled(size_t set) {
-    if (elog.enabled_fmt_set & set) {
+static bool get_fmt_enabled(ElogLogger_t logger, size_t set) {
+    if (logger->enabled_fmt_set & set) {
         return true;
     } else {
         return false;
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Coalesce the repeated log to "last message repeated N times".
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+#include <stdio.h>
+
+#ifdef ELOG_USING_COALESCE
+
+/* the repeated info max length */
+#define REPEATED_INFO_MAX_LEN                48
+
+/* last output log's info */
+typedef struct {
+    uint32_t hash;
+    size_t repeated;
+    uint32_t first_repeated_ms;
+} ElogCoalesce, *ElogCoalesce_t;
+
+static ElogCoalesce last_log = { 0 };
+
+/**
+ * Check the log is repeated or not by the call site and the log content hash.
+ * The caller must hold the output lock.
+ *
+ * @param file file name
+ * @param line line number
+ * @param log log content without header info
+ * @param size log content size
+ *
+ * @return true: the log should be output, false: it's repeated and has been counted
+ */
+bool elog_coalesce_check(const char *file, long line, const char *log, size_t size) {
+    uint32_t hash = ELOG_HASH_INIT;
+
+    hash = elog_hash(hash, &file, sizeof(file));
+    hash = elog_hash(hash, &line, sizeof(line));
+    hash = elog_hash(hash, log, size);
+
+    if (hash == last_log.hash) {
+        if (last_log.repeated++ == 0) {
+            last_log.first_repeated_ms = elog_port_get_ms();
+        } else if (elog_port_get_ms() - last_log.first_repeated_ms >= ELOG_COALESCE_TIMEOUT) {
+            elog_coalesce_flush();
+        }
+        return false;
+    }
+
+    /* the log has changed */
+    elog_coalesce_flush();
+    last_log.hash = hash;
+
+    return true;
+}
+
+/**
+ * Output the repeated info if the last log has been repeated.
+ * The caller must hold the output lock.
+ */
+void elog_coalesce_flush(void) {
+    char info[REPEATED_INFO_MAX_LEN];
+    int len;
+
+    if (last_log.repeated) {
+        len = snprintf(info, REPEATED_INFO_MAX_LEN, "last message repeated %lu times\r\n",
+                (unsigned long) last_log.repeated);
+        if (len > 0) {
+            elog_port_output(info, len < REPEATED_INFO_MAX_LEN ? len : REPEATED_INFO_MAX_LEN - 1);
+        }
+        last_log.repeated = 0;
+    }
+}
+
+#endif /* ELOG_USING_COALESCE */
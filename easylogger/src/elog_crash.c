@@ -0,0 +1,231 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Crash log. The newest logs are kept in no-init RAM, so they can survive a warm reset.
+ * Created on: 2026-10-19
+ *
+ * Each log is saved with a check code after it, so the logs which are corrupted by wild write
+ * before the reset are found and cut when they are replayed. The log must end with '\n', then the
+ * record can be found by forward scan after the oldest log is partly overwritten.
+ */
+
+#include "elog.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ELOG_USING_CRASH_LOG
+
+/* the magic word for crash log, it's "ELOG" */
+#define CRASH_LOG_MAGIC                      0x454C4F47
+/* the check code size after each log */
+#define CRASH_LOG_CHECK_SIZE                 4
+/* the byte in ring buffer */
+#define CRASH_LOG_BYTE(pos)                  (crash_log.buf[(pos) % ELOG_CRASH_LOG_BUF_SIZE])
+
+/* crash log in no-init RAM */
+typedef struct {
+    uint32_t magic;
+    ElogRing ring;
+    /* check code for magic and ring buffer info, each log has it's own check code in buffer */
+    uint32_t check;
+    char buf[ELOG_CRASH_LOG_BUF_SIZE];
+} ElogCrashLog, *ElogCrashLog_t;
+
+static ELOG_CRASH_LOG_ATTR ElogCrashLog crash_log;
+
+static uint32_t calc_check(void);
+static void replay(void);
+static size_t find_record(size_t pos, size_t size);
+static void output_record(size_t pos, size_t size);
+
+/**
+ * Crash log initialize. It will be called by elog_init.
+ * The last boot's logs will be replayed if they have survived the reset.
+ *
+ * @return true: the last boot's logs has been found
+ */
+bool elog_crash_log_init(void) {
+    static const char *begin_info = "---------- last boot log begin ----------\r\n";
+    static const char *end_info = "----------- last boot log end -----------\r\n";
+    bool found = false;
+
+    /* check the crash log is valid or not. it's random data after power on. */
+    if (crash_log.magic == CRASH_LOG_MAGIC && crash_log.ring.buf == crash_log.buf
+            && crash_log.ring.size == ELOG_CRASH_LOG_BUF_SIZE && crash_log.ring.write_pos < ELOG_CRASH_LOG_BUF_SIZE
+            && crash_log.check == calc_check()) {
+        found = true;
+        /* replay the last boot's logs */
+        elog_port_output_lock();
+        elog_port_output(begin_info, strlen(begin_info));
+        replay();
+        elog_port_output(end_info, strlen(end_info));
+        elog_port_output_unlock();
+    }
+
+    /* start to record this boot's logs */
+    crash_log.magic = CRASH_LOG_MAGIC;
+    crash_log.ring.buf = crash_log.buf;
+    crash_log.ring.size = ELOG_CRASH_LOG_BUF_SIZE;
+    crash_log.ring.write_pos = 0;
+    crash_log.ring.full = false;
+    crash_log.check = calc_check();
+
+    return found;
+}
+
+/**
+ * Record the log to crash log. It only has memory stores, so it's fast.
+ * The caller must hold the output lock.
+ *
+ * @param log log
+ * @param size log size
+ */
+void elog_crash_log_write(const char *log, size_t size) {
+    uint8_t check[CRASH_LOG_CHECK_SIZE];
+    uint32_t hash;
+    size_t i;
+
+    /* crash log is not initialized */
+    if (crash_log.magic != CRASH_LOG_MAGIC) {
+        return;
+    }
+    /* only the newest data will be saved when it is larger than ring buffer */
+    if (size + CRASH_LOG_CHECK_SIZE > ELOG_CRASH_LOG_BUF_SIZE) {
+        log += size + CRASH_LOG_CHECK_SIZE - ELOG_CRASH_LOG_BUF_SIZE;
+        size = ELOG_CRASH_LOG_BUF_SIZE - CRASH_LOG_CHECK_SIZE;
+    }
+
+    hash = elog_hash(ELOG_HASH_INIT, log, size);
+    for (i = 0; i < CRASH_LOG_CHECK_SIZE; i++) {
+        check[i] = (uint8_t) (hash >> (i * 8));
+    }
+    elog_ring_write(&crash_log.ring, log, size);
+    elog_ring_write(&crash_log.ring, (const char *) check, sizeof(check));
+    crash_log.check = calc_check();
+}
+
+/**
+ * Replay the valid logs from oldest to newest. The bytes which don't belong to a valid log are cut,
+ * they are the oldest log which is partly overwritten or the corrupted data.
+ */
+static void replay(void) {
+    char cut_info[64];
+    size_t used, start, offset = 0, size, cut = 0;
+    bool synced;
+    int len;
+
+    if (crash_log.ring.full) {
+        used = ELOG_CRASH_LOG_BUF_SIZE;
+        start = crash_log.ring.write_pos;
+        synced = false;
+    } else {
+        used = crash_log.ring.write_pos;
+        start = 0;
+        synced = true;
+    }
+
+    while (offset < used) {
+        size = find_record(start + offset, used - offset);
+        if (size) {
+            output_record(start + offset, size);
+            offset += size + CRASH_LOG_CHECK_SIZE;
+            synced = true;
+        } else {
+            /* the partly overwritten oldest log isn't corrupted data */
+            if (synced) {
+                cut++;
+            }
+            offset++;
+        }
+    }
+
+    if (cut) {
+        len = snprintf(cut_info, sizeof(cut_info), "[elog crash] %lu corrupted bytes are cut\r\n",
+                (unsigned long) cut);
+        if (len > 0 && (size_t) len < sizeof(cut_info)) {
+            elog_port_output(cut_info, len);
+        }
+    }
+}
+
+/**
+ * find the valid log which starts at the position
+ *
+ * @param pos start position in ring buffer
+ * @param size the max size of log and it's check code
+ *
+ * @return log size, 0: there is no valid log at this position
+ */
+static size_t find_record(size_t pos, size_t size) {
+    uint32_t hash = ELOG_HASH_INIT, check;
+    size_t len, i;
+    char c;
+
+    /* the log maybe has '\n' in it, so each '\n' is tried. the log is not longer than log buffer. */
+    for (len = 1; len + CRASH_LOG_CHECK_SIZE <= size && len <= ELOG_BUF_SIZE; len++) {
+        c = CRASH_LOG_BYTE(pos + len - 1);
+        hash = elog_hash(hash, &c, 1);
+        if (c == '\n') {
+            check = 0;
+            for (i = 0; i < CRASH_LOG_CHECK_SIZE; i++) {
+                check |= (uint32_t) (uint8_t) CRASH_LOG_BYTE(pos + len + i) << (i * 8);
+            }
+            if (check == hash) {
+                return len;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * output the log in ring buffer, it maybe is divided into two parts
+ *
+ * @param pos start position in ring buffer
+ * @param size log size
+ */
+static void output_record(size_t pos, size_t size) {
+    size_t first_size;
+
+    pos %= ELOG_CRASH_LOG_BUF_SIZE;
+    first_size = ELOG_CRASH_LOG_BUF_SIZE - pos;
+    if (first_size >= size) {
+        elog_port_output(crash_log.buf + pos, size);
+    } else {
+        elog_port_output(crash_log.buf + pos, first_size);
+        elog_port_output(crash_log.buf, size - first_size);
+    }
+}
+
+/**
+ * calculate the check code for crash log header
+ *
+ * @return check code
+ */
+static uint32_t calc_check(void) {
+    uint32_t check = ELOG_HASH_INIT;
+
+    check = elog_hash(check, &crash_log.magic, sizeof(crash_log.magic));
+    check = elog_hash(check, &crash_log.ring.write_pos, sizeof(crash_log.ring.write_pos));
+    check = elog_hash(check, &crash_log.ring.full, sizeof(crash_log.ring.full));
+
+    return check;
+}
+
+#endif /* ELOG_USING_CRASH_LOG */
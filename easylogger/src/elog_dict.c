@@ -0,0 +1,132 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Dictionary log. The tag, format and file name are replaced by ID, only the ID and
+ *           arguments are output as binary frame. It's decoded by tools/elog_dict.py on host.
+ * Created on: 2026-10-19
+ *
+ * Frame format:
+ *
+ * | sync (0xA5) | head | ID | time (ms) | argument 0 | ... | argument N-1 | check |
+ *
+ * head: 0x80 | (level << 4) | argument number
+ * ID, time and arguments: variable length unsigned integer. The low 7 bits are saved in the
+ *     leading bytes with 0x80 flag, and the last 6 bits are saved in the end byte with 0x40 flag.
+ * check: 0x80 | (sum of bytes from head to the last argument & 0x7F)
+ *
+ * There is no byte which is less than 0x40 in the frame, so it can be mixed with text log and
+ * can be output by string function, such as rt_kprintf("%.*s").
+ */
+
+#include "elog.h"
+#include <string.h>
+
+#ifdef ELOG_USING_DICT
+
+/* frame sync byte */
+#define DICT_SYNC                            0xA5
+/* the max size of a variable length 32 bits integer */
+#define DICT_VARINT_MAX_SIZE                 5
+/* the max frame size */
+#define DICT_FRAME_MAX_SIZE                  (3 + (2 + ELOG_DICT_ARGS_MAX) * DICT_VARINT_MAX_SIZE)
+
+static size_t put_varint(uint8_t *buf, uint32_t value);
+
+/**
+ * Output the dictionary log. It's called by elog_id_a ~ elog_id_v, the log can't be filtered by tag.
+ *
+ * @param level level
+ * @param id log ID which is assigned by tools/elog_dict.py
+ * @param argc argument number
+ * @param ... arguments, each argument must be uint32_t
+ */
+void elog_dict_output(uint8_t level, uint32_t id, size_t argc, ...) {
+    uint8_t frame[DICT_FRAME_MAX_SIZE], check = 0;
+    size_t len = 0, i;
+    va_list args;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    ELOG_ASSERT(argc <= ELOG_DICT_ARGS_MAX);
+
+    /* check output enabled and level filter */
+    if (!elog_get_output_enabled() || level > elog_get_filter_lvl()) {
+        return;
+    }
+
+    /* args point to the first variable parameter */
+    va_start(args, argc);
+
+    frame[len++] = DICT_SYNC;
+    frame[len++] = (uint8_t) (0x80 | (level << 4) | argc);
+    len += put_varint(frame + len, id);
+    len += put_varint(frame + len, elog_port_get_ms());
+    for (i = 0; i < argc; i++) {
+        len += put_varint(frame + len, va_arg(args, uint32_t));
+    }
+    for (i = 1; i < len; i++) {
+        check += frame[i];
+    }
+    frame[len++] = (uint8_t) (0x80 | (check & 0x7F));
+
+    va_end(args);
+
+    /* lock output */
+    elog_port_output_lock();
+
+    elog_port_output((const char *) frame, len);
+
+    /* unlock output */
+    elog_port_output_unlock();
+}
+
+/**
+ * Convert the float argument to uint32_t for dictionary log, it's used by elog_id_float.
+ *
+ * @param value float value
+ *
+ * @return float bits
+ */
+uint32_t elog_dict_float(float value) {
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+/**
+ * put the variable length integer to buffer
+ *
+ * @param buf buffer
+ * @param value value
+ *
+ * @return used buffer size
+ */
+static size_t put_varint(uint8_t *buf, uint32_t value) {
+    size_t len = 0;
+
+    while (value >= 0x40) {
+        buf[len++] = (uint8_t) (0x80 | (value & 0x7F));
+        value >>= 7;
+    }
+    buf[len++] = (uint8_t) (0x40 | value);
+
+    return len;
+}
+
+#endif /* ELOG_USING_DICT */
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Flight recorder. Record all logs to RAM ring buffer and dump it on demand.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+#include <string.h>
+
+#ifdef ELOG_USING_FLIGHT_RECORDER
+
+/* flight recorder buffer */
+static char flight_buf[ELOG_FLIGHT_BUF_SIZE];
+/* flight recorder */
+static ElogRing flight = { flight_buf, ELOG_FLIGHT_BUF_SIZE, 0, false };
+
+/**
+ * Record the log to flight recorder.
+ * The caller must hold the output lock.
+ *
+ * @param log log
+ * @param size log size
+ */
+void elog_flight_write(const char *log, size_t size) {
+    elog_ring_write(&flight, log, size);
+}
+
+/**
+ * Output the newest logs in flight recorder.
+ * The caller must hold the output lock.
+ *
+ * @param size max output size, 0: output all logs
+ */
+void elog_flight_output(size_t size) {
+    static const char *begin_info = "---------- flight recorder dump begin ----------\r\n";
+    static const char *end_info = "----------- flight recorder dump end -----------\r\n";
+
+    elog_port_output(begin_info, strlen(begin_info));
+    elog_ring_output(&flight, size);
+    elog_port_output(end_info, strlen(end_info));
+}
+
+/**
+ * dump the newest logs in flight recorder
+ *
+ * @param size max dump size, 0: dump all logs
+ */
+void elog_flight_dump(size_t size) {
+    /* lock output */
+    elog_port_output_lock();
+
+    elog_flight_output(size);
+
+    /* unlock output */
+    elog_port_output_unlock();
+}
+
+#endif /* ELOG_USING_FLIGHT_RECORDER */
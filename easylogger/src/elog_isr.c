@@ -0,0 +1,156 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: ISR log buffer. The log in ISR is saved without lock, and it will be output in thread context.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+#include <stdio.h>
+
+#ifdef ELOG_USING_ISR
+
+/* ISR log lane. The logs are saved to the lane by level band, and the higher priority lane is output first. */
+typedef struct {
+    ElogIsrLog_t logs;
+    size_t size;
+    /* the next write and read index. they only increase, the buffer index is index % size */
+    volatile size_t write_index, read_index;
+    /* dropped log number when the lane is full */
+    volatile size_t dropped_num;
+} ElogIsrLane, *ElogIsrLane_t;
+
+/* ISR log buffer of each lane */
+static ElogIsrLog fault_logs[ELOG_ISR_BUF_FAULT_NUM];
+static ElogIsrLog info_logs[ELOG_ISR_BUF_NUM];
+static ElogIsrLog debug_logs[ELOG_ISR_BUF_NUM];
+static ElogIsrLane lanes[ELOG_ISR_LANE_NUM] = {
+        { fault_logs, ELOG_ISR_BUF_FAULT_NUM, 0, 0, 0 },
+        { info_logs, ELOG_ISR_BUF_NUM, 0, 0, 0 },
+        { debug_logs, ELOG_ISR_BUF_NUM, 0, 0, 0 },
+};
+/* the lane of the log which is returned by elog_isr_read */
+static ElogIsrLane_t read_lane = NULL;
+
+/**
+ * Save the log to ISR log buffer. It can be called in ISR.
+ * The interrupt is only disabled when the buffer is allocated, the log formatting is out of it.
+ * The log will use the free buffer of lower priority lanes when it's own lane is full,
+ * so the assert and error log is only dropped when all lanes are full.
+ *
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ */
+void elog_isr_write(uint8_t level, const char *tag, const char *file, const char *func, long line,
+        const char *format, va_list args) {
+    ElogIsrLane_t lane = NULL;
+    ElogIsrLog_t isr_log;
+    uint32_t irq_level;
+    size_t i;
+
+    /* allocate a buffer */
+    irq_level = elog_port_irq_disable();
+    for (i = ELOG_ISR_LANE(level); i < ELOG_ISR_LANE_NUM; i++) {
+        if (lanes[i].write_index - lanes[i].read_index < lanes[i].size) {
+            lane = &lanes[i];
+            break;
+        }
+    }
+    if (!lane) {
+        lanes[ELOG_ISR_LANE(level)].dropped_num++;
+        elog_port_irq_enable(irq_level);
+        return;
+    }
+    isr_log = &lane->logs[lane->write_index++ % lane->size];
+    elog_port_irq_enable(irq_level);
+
+    isr_log->level = level;
+    isr_log->tag = tag;
+    isr_log->file = file;
+    isr_log->func = func;
+    isr_log->line = line;
+    isr_log->ms = elog_port_get_ms();
+    vsnprintf(isr_log->log, ELOG_ISR_LOG_MAX_LEN, format, args);
+    /* the log can be read now */
+    isr_log->ready = true;
+}
+
+/**
+ * Read the oldest ISR log of the highest priority lane in thread context. It should be released by
+ * elog_isr_release after output. The lanes are checked from the highest priority on each read, so the
+ * new assert or error log is output before the remaining lower priority logs.
+ * The caller must hold the output lock.
+ *
+ * @return the ISR log, NULL: there is no log or the oldest log of each lane is being written
+ */
+ElogIsrLog_t elog_isr_read(void) {
+    ElogIsrLog_t isr_log;
+    size_t i;
+
+    for (i = 0; i < ELOG_ISR_LANE_NUM; i++) {
+        if (lanes[i].read_index == lanes[i].write_index) {
+            continue;
+        }
+        isr_log = &lanes[i].logs[lanes[i].read_index % lanes[i].size];
+        if (isr_log->ready) {
+            read_lane = &lanes[i];
+            return isr_log;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * release the ISR log which has been read
+ */
+void elog_isr_release(void) {
+    ELOG_ASSERT(read_lane);
+
+    read_lane->logs[read_lane->read_index % read_lane->size].ready = false;
+    read_lane->read_index++;
+    read_lane = NULL;
+}
+
+/**
+ * get the dropped ISR log number of the lane since last get
+ *
+ * @param lane lane, see ELOG_ISR_LANE
+ *
+ * @return dropped log number
+ */
+size_t elog_isr_get_dropped(size_t lane) {
+    size_t dropped;
+    uint32_t irq_level;
+
+    ELOG_ASSERT(lane < ELOG_ISR_LANE_NUM);
+
+    irq_level = elog_port_irq_disable();
+    dropped = lanes[lane].dropped_num;
+    lanes[lane].dropped_num = 0;
+    elog_port_irq_enable(irq_level);
+
+    return dropped;
+}
+
+#endif /* ELOG_USING_ISR */
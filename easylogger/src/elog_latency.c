@@ -0,0 +1,263 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Self-latency histogram. The latency (cycles) of log API and elog_port_output is counted to
+ *           log-linear buckets, each power of two range is split to (1 << ELOG_LATENCY_SUB_BITS) buckets.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ELOG_USING_LATENCY
+
+#define SUB_NUM                              (1UL << ELOG_LATENCY_SUB_BITS)
+#define BUCKET_NUM                           (ELOG_LATENCY_GROUP_NUM * SUB_NUM)
+/* the max latency dump line length */
+#define DUMP_LINE_MAX_LEN                    96
+
+/* latency histogram */
+typedef struct {
+    uint32_t buckets[BUCKET_NUM];
+    uint32_t count;
+    uint32_t max;
+} ElogLatencyHist, *ElogLatencyHist_t;
+
+static ElogLatencyHist hists[ELOG_LATENCY_TYPE_NUM];
+
+static const char *type_name[] = {
+        "call",                                  /**< ELOG_LATENCY_CALL */
+        "port output",                           /**< ELOG_LATENCY_OUTPUT */
+};
+
+static size_t bucket_index(uint32_t cycles);
+static void count_inc(uint32_t *count);
+static void dump_line(const char *format, ...);
+
+/**
+ * get the bucket index of the latency
+ *
+ * @param cycles latency (cycles)
+ *
+ * @return bucket index, the too long latency is counted to the last bucket
+ */
+static size_t bucket_index(uint32_t cycles) {
+    uint8_t msb = 0;
+    size_t index;
+
+    if (cycles < SUB_NUM) {
+        return cycles;
+    }
+
+    while ((cycles >> msb) > 1) {
+        msb++;
+    }
+    index = ((size_t) (msb - ELOG_LATENCY_SUB_BITS + 1) << ELOG_LATENCY_SUB_BITS)
+            | ((cycles >> (msb - ELOG_LATENCY_SUB_BITS)) & (SUB_NUM - 1));
+
+    return index < BUCKET_NUM ? index : BUCKET_NUM - 1;
+}
+
+/**
+ * get the min latency of the bucket
+ *
+ * @param index bucket index
+ *
+ * @return min latency (cycles)
+ */
+uint32_t elog_latency_bucket_min(size_t index) {
+    size_t group = index >> ELOG_LATENCY_SUB_BITS, sub = index & (SUB_NUM - 1);
+
+    ELOG_ASSERT(index < BUCKET_NUM);
+
+    if (group == 0) {
+        return sub;
+    }
+
+    return (uint32_t) (SUB_NUM + sub) << (group - 1);
+}
+
+/**
+ * Record the latency to histogram. It can be called in ISR and without lock.
+ *
+ * @param type latency type
+ * @param cycles latency (cycles)
+ */
+void elog_latency_record(ElogLatencyType type, uint32_t cycles) {
+    ElogLatencyHist_t hist = &hists[type];
+
+    ELOG_ASSERT(type < ELOG_LATENCY_TYPE_NUM);
+
+    count_inc(&hist->buckets[bucket_index(cycles)]);
+    count_inc(&hist->count);
+    /* the max latency maybe lost when it's recorded concurrently, but it will be corrected by next longer one */
+    if (cycles > hist->max) {
+        hist->max = cycles;
+    }
+}
+
+/**
+ * get the recorded latency number
+ *
+ * @param type latency type
+ *
+ * @return latency number
+ */
+uint32_t elog_latency_get_count(ElogLatencyType type) {
+    ELOG_ASSERT(type < ELOG_LATENCY_TYPE_NUM);
+
+    return hists[type].count;
+}
+
+/**
+ * get the max recorded latency
+ *
+ * @param type latency type
+ *
+ * @return max latency (cycles)
+ */
+uint32_t elog_latency_get_max(ElogLatencyType type) {
+    ELOG_ASSERT(type < ELOG_LATENCY_TYPE_NUM);
+
+    return hists[type].max;
+}
+
+/**
+ * Get the latency percentile. It's the upper bound of the bucket, so the error is 1/(1 << ELOG_LATENCY_SUB_BITS)
+ * at most, and it won't be greater than the max latency.
+ *
+ * @param type latency type
+ * @param permille percentile (permille), such as 500: p50, 990: p99, 999: p99.9
+ *
+ * @return latency (cycles), 0: there is no latency recorded
+ */
+uint32_t elog_latency_get_percentile(ElogLatencyType type, uint16_t permille) {
+    ElogLatencyHist_t hist = &hists[type];
+    uint32_t count = 0, rank, upper;
+    size_t i;
+
+    ELOG_ASSERT(type < ELOG_LATENCY_TYPE_NUM);
+    ELOG_ASSERT(permille <= 1000);
+
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    /* the rank of the percentile, it's 1 at least */
+    rank = (uint32_t) (((uint64_t) hist->count * permille + 999) / 1000);
+    if (rank == 0) {
+        rank = 1;
+    }
+    for (i = 0; i < BUCKET_NUM - 1; i++) {
+        count += hist->buckets[i];
+        if (count >= rank) {
+            upper = elog_latency_bucket_min(i + 1) - 1;
+            return upper < hist->max ? upper : hist->max;
+        }
+    }
+
+    return hist->max;
+}
+
+/**
+ * clean all recorded latency
+ */
+void elog_latency_clean(void) {
+    uint32_t irq_level;
+
+    irq_level = elog_port_irq_disable();
+    memset(hists, 0, sizeof(hists));
+    elog_port_irq_enable(irq_level);
+}
+
+/**
+ * dump the latency histograms, the empty bucket won't be dumped
+ */
+void elog_latency_dump(void) {
+    ElogLatencyHist_t hist;
+    size_t type, i;
+
+    /* lock output */
+    elog_port_output_lock();
+
+    for (type = 0; type < ELOG_LATENCY_TYPE_NUM; type++) {
+        hist = &hists[type];
+        dump_line("---------- %s latency (cycles) ----------\r\n", type_name[type]);
+        dump_line("count: %lu, max: %lu, p50: %lu, p90: %lu, p99: %lu, p99.9: %lu\r\n",
+                (unsigned long) hist->count, (unsigned long) hist->max,
+                (unsigned long) elog_latency_get_percentile((ElogLatencyType) type, 500),
+                (unsigned long) elog_latency_get_percentile((ElogLatencyType) type, 900),
+                (unsigned long) elog_latency_get_percentile((ElogLatencyType) type, 990),
+                (unsigned long) elog_latency_get_percentile((ElogLatencyType) type, 999));
+        for (i = 0; i < BUCKET_NUM; i++) {
+            if (hist->buckets[i] == 0) {
+                continue;
+            }
+            if (i == BUCKET_NUM - 1) {
+                dump_line("%10lu ~          : %lu\r\n", (unsigned long) elog_latency_bucket_min(i),
+                        (unsigned long) hist->buckets[i]);
+            } else {
+                dump_line("%10lu ~ %10lu: %lu\r\n", (unsigned long) elog_latency_bucket_min(i),
+                        (unsigned long) elog_latency_bucket_min(i + 1) - 1, (unsigned long) hist->buckets[i]);
+            }
+        }
+    }
+
+    /* unlock output */
+    elog_port_output_unlock();
+}
+
+/**
+ * increase the counter, it's atomic for ISR and other CPU
+ *
+ * @param count counter
+ */
+static void count_inc(uint32_t *count) {
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)
+    __atomic_fetch_add(count, 1, __ATOMIC_RELAXED);
+#else
+    uint32_t irq_level;
+
+    irq_level = elog_port_irq_disable();
+    (*count)++;
+    elog_port_irq_enable(irq_level);
+#endif
+}
+
+/**
+ * format and output a dump line
+ *
+ * @param format output format
+ * @param ... args
+ */
+static void dump_line(const char *format, ...) {
+    char line[DUMP_LINE_MAX_LEN];
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (len > 0) {
+        elog_port_output(line, (size_t) len < sizeof(line) ? (size_t) len : sizeof(line) - 1);
+    }
+}
+
+#endif /* ELOG_USING_LATENCY */
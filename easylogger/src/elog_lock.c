@@ -0,0 +1,111 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Built-in output lock. It's a ticket lock by C11 atomics, so the port needn't implement
+ *           elog_port_output_lock and elog_port_output_unlock by the kernel IPC object.
+ * Created on: 2026-10-19
+ *
+ * The locker takes a ticket by an atomic add on the next ticket, then waits for the owner ticket is
+ * equal to it, so the lock is granted in FIFO order. The waiter backs off by the number of waiters
+ * before it, which reduces the traffic on the owner ticket. The lock holder maybe preempted on the
+ * single core or by the thread with higher priority, so the waiter yields the CPU by
+ * elog_port_lock_yield after ELOG_TICKET_LOCK_SPIN_MAX spins.
+ */
+
+#include "elog.h"
+
+#ifdef ELOG_USING_TICKET_LOCK
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__)
+#error "ELOG_USING_TICKET_LOCK needs the C11 atomics, please use the port output lock."
+#endif
+
+#include <stdatomic.h>
+
+/* relax the CPU in the spin loop */
+#if defined(__i386__) || defined(__x86_64__)
+#define ELOG_CPU_RELAX()                     __asm__ volatile ("pause" ::: "memory")
+#elif defined(__arm__) || defined(__aarch64__)
+#define ELOG_CPU_RELAX()                     __asm__ volatile ("yield" ::: "memory")
+#else
+#define ELOG_CPU_RELAX()                     atomic_signal_fence(memory_order_seq_cst)
+#endif
+
+/* ticket lock */
+typedef struct {
+    /* the next ticket to take */
+    atomic_uint next;
+    /* the ticket which holds the lock */
+    atomic_uint owner;
+} ElogTicketLock, *ElogTicketLock_t;
+
+static ElogTicketLock output_lock;
+
+static void ticket_lock(ElogTicketLock_t lock);
+static void ticket_unlock(ElogTicketLock_t lock);
+
+/**
+ * output lock
+ */
+void elog_port_output_lock(void) {
+    ticket_lock(&output_lock);
+}
+
+/**
+ * output unlock
+ */
+void elog_port_output_unlock(void) {
+    ticket_unlock(&output_lock);
+}
+
+/**
+ * take a ticket and wait for it's served
+ *
+ * @param lock ticket lock
+ */
+static void ticket_lock(ElogTicketLock_t lock) {
+    unsigned int ticket, owner, spin, budget = ELOG_TICKET_LOCK_SPIN_MAX;
+
+    ticket = atomic_fetch_add_explicit(&lock->next, 1, memory_order_relaxed);
+    while ((owner = atomic_load_explicit(&lock->owner, memory_order_acquire)) != ticket) {
+        /* proportional backoff, each waiter before this one holds the lock for a while */
+        spin = (ticket - owner) * ELOG_TICKET_LOCK_BACKOFF;
+        if (spin <= budget) {
+            budget -= spin;
+            for (; spin > 0; spin--) {
+                ELOG_CPU_RELAX();
+            }
+        } else {
+            /* the lock holder maybe preempted, let it run */
+            elog_port_lock_yield();
+        }
+    }
+}
+
+/**
+ * serve the next ticket
+ *
+ * @param lock ticket lock
+ */
+static void ticket_unlock(ElogTicketLock_t lock) {
+    unsigned int owner = atomic_load_explicit(&lock->owner, memory_order_relaxed);
+
+    atomic_store_explicit(&lock->owner, owner + 1, memory_order_release);
+}
+
+#endif /* ELOG_USING_TICKET_LOCK */
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Per-CPU log buffer. The log is saved to the buffer of current CPU with it's own lock,
+ *           and the logs of all CPUs are merged by sequence number when they are output.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+
+#ifdef ELOG_USING_PERCPU
+
+#if defined(ELOG_USING_RATE_LIMIT) || defined(ELOG_USING_SAMPLE) || defined(ELOG_USING_THROTTLE)
+#error "The rate limit, sampling and throttling need the output lock, they can't be used with per-CPU log buffer."
+#endif
+
+/* the log buffer of one CPU */
+typedef struct {
+    ElogCpuLog logs[ELOG_PERCPU_BUF_NUM];
+    /* the next write and read index, they only increase and are changed with the CPU lock */
+    size_t write_index, read_index;
+    /* dropped log number when the buffer is full */
+    size_t dropped_num;
+} ElogCpuBuf, *ElogCpuBuf_t;
+
+static ElogCpuBuf cpu_bufs[ELOG_PERCPU_CPU_NUM];
+/* the write index snapshot and the read cursor of each CPU buffer when merging, they are only used by reader */
+static size_t write_snap[ELOG_PERCPU_CPU_NUM], read_cursor[ELOG_PERCPU_CPU_NUM];
+/* the CPU of the log which is returned by elog_percpu_read */
+static uint8_t read_cpu = 0;
+
+/**
+ * Allocate a log from the CPU buffer. The log is visible to reader after elog_percpu_commit.
+ * The caller must hold the CPU lock.
+ *
+ * @param cpu CPU index
+ *
+ * @return the log, NULL: the buffer is full
+ */
+ElogCpuLog_t elog_percpu_alloc(uint8_t cpu) {
+    ElogCpuBuf_t cpu_buf = &cpu_bufs[cpu];
+
+    ELOG_ASSERT(cpu < ELOG_PERCPU_CPU_NUM);
+
+    if (cpu_buf->write_index - cpu_buf->read_index >= ELOG_PERCPU_BUF_NUM) {
+        cpu_buf->dropped_num++;
+        return NULL;
+    }
+
+    return &cpu_buf->logs[cpu_buf->write_index % ELOG_PERCPU_BUF_NUM];
+}
+
+/**
+ * Commit the log which is allocated by elog_percpu_alloc, then it can be read.
+ * The caller must hold the CPU lock.
+ *
+ * @param cpu CPU index
+ */
+void elog_percpu_commit(uint8_t cpu) {
+    ELOG_ASSERT(cpu < ELOG_PERCPU_CPU_NUM);
+
+    cpu_bufs[cpu].write_index++;
+}
+
+/**
+ * Begin to read the logs of all CPUs. Only the logs which are committed before it will be read.
+ * The caller must hold the output lock.
+ */
+void elog_percpu_begin(void) {
+    uint8_t cpu;
+
+    for (cpu = 0; cpu < ELOG_PERCPU_CPU_NUM; cpu++) {
+        elog_port_cpu_lock(cpu);
+        write_snap[cpu] = cpu_bufs[cpu].write_index;
+        read_cursor[cpu] = cpu_bufs[cpu].read_index;
+        elog_port_cpu_unlock(cpu);
+    }
+}
+
+/**
+ * Read the earliest log of all CPUs by sequence number. It should be released by elog_percpu_release
+ * after output.
+ * The caller must hold the output lock.
+ *
+ * @return the earliest log, NULL: all logs have been read
+ */
+ElogCpuLog_t elog_percpu_read(void) {
+    ElogCpuLog_t cpu_log = NULL, head;
+    uint8_t cpu;
+
+    for (cpu = 0; cpu < ELOG_PERCPU_CPU_NUM; cpu++) {
+        if (read_cursor[cpu] == write_snap[cpu]) {
+            continue;
+        }
+        head = &cpu_bufs[cpu].logs[read_cursor[cpu] % ELOG_PERCPU_BUF_NUM];
+        if (!cpu_log || head->seq < cpu_log->seq) {
+            cpu_log = head;
+            read_cpu = cpu;
+        }
+    }
+
+    return cpu_log;
+}
+
+/**
+ * release the log which has been read
+ */
+void elog_percpu_release(void) {
+    read_cursor[read_cpu]++;
+}
+
+/**
+ * End to read the logs, the released logs buffer can be allocated again.
+ * The caller must hold the output lock.
+ */
+void elog_percpu_end(void) {
+    uint8_t cpu;
+
+    for (cpu = 0; cpu < ELOG_PERCPU_CPU_NUM; cpu++) {
+        elog_port_cpu_lock(cpu);
+        cpu_bufs[cpu].read_index = read_cursor[cpu];
+        elog_port_cpu_unlock(cpu);
+    }
+}
+
+/**
+ * get the dropped log number of the CPU since last get
+ *
+ * @param cpu CPU index
+ *
+ * @return dropped log number
+ */
+size_t elog_percpu_get_dropped(uint8_t cpu) {
+    size_t dropped;
+
+    ELOG_ASSERT(cpu < ELOG_PERCPU_CPU_NUM);
+
+    elog_port_cpu_lock(cpu);
+    dropped = cpu_bufs[cpu].dropped_num;
+    cpu_bufs[cpu].dropped_num = 0;
+    elog_port_cpu_unlock(cpu);
+
+    return dropped;
+}
+
+#endif /* ELOG_USING_PERCPU */
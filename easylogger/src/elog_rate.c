@@ -0,0 +1,196 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Token bucket rate limit for each log call site.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+
+#ifdef ELOG_USING_RATE_LIMIT
+
+/* the token is scaled by 1000, so the refill can be calculated by millisecond */
+#define TOKEN_SCALE                          1000
+
+/* rate limit bucket for a call site */
+typedef struct {
+    const char *file;
+    long line;
+    uint32_t tokens;
+    uint32_t last_ms;
+    size_t suppressed;
+} ElogRateSite, *ElogRateSite_t;
+
+/* burst and rate setting for each level */
+static uint16_t level_burst[ELOG_LVL_VERBOSE + 1];
+static uint16_t level_rate[ELOG_LVL_VERBOSE + 1];
+/* call site buckets. the least recently used one is reused by new call site when all buckets are used */
+static ElogRateSite sites[ELOG_RATE_LIMIT_SITE_MAX];
+/* default setting has been loaded */
+static bool init_ok = false;
+/* the call site and it's suppressed log number when it's bucket is evicted, it's reported by the caller */
+static const char *evicted_file = NULL;
+static long evicted_line = 0;
+static size_t evicted_suppressed = 0;
+
+static void load_default_setting(void);
+static ElogRateSite_t find_site(const char *file, long line, uint32_t now);
+
+/**
+ * set the rate limit for a level
+ *
+ * @param level level
+ * @param burst max burst log number of each call site, 0: disable the limit on this level
+ * @param rate log number per second after the burst is used up, it must be greater than 0 when the limit is enabled
+ */
+void elog_set_rate_limit(uint8_t level, uint16_t burst, uint16_t rate) {
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    ELOG_ASSERT(burst == 0 || rate > 0);
+
+    if (!init_ok) {
+        load_default_setting();
+    }
+
+    level_burst[level] = burst;
+    level_rate[level] = rate;
+}
+
+/**
+ * Check the call site can output this log or not.
+ * The caller must hold the output lock.
+ *
+ * @param level level
+ * @param file file name
+ * @param line line number
+ * @param suppressed the suppressed log number since last output, it will be reported when the limit reopens
+ *
+ * @return true: can output, false: this log should be dropped
+ */
+bool elog_rate_limit_check(uint8_t level, const char *file, long line, size_t *suppressed) {
+    ElogRateSite_t site;
+    uint32_t now, elapsed, burst_tokens;
+
+    *suppressed = 0;
+
+    if (!init_ok) {
+        load_default_setting();
+    }
+    /* this level has no limit */
+    if (level_burst[level] == 0) {
+        return true;
+    }
+
+    burst_tokens = (uint32_t) level_burst[level] * TOKEN_SCALE;
+    now = elog_port_get_ms();
+    site = find_site(file, line, now);
+    if (site->file == NULL) {
+        /* new call site, the bucket is full */
+        site->file = file;
+        site->line = line;
+        site->tokens = burst_tokens;
+        site->last_ms = now;
+    } else {
+        /* refill the bucket. limit the elapsed time to avoid overflow */
+        elapsed = now - site->last_ms;
+        site->last_ms = now;
+        if (elapsed >= burst_tokens / level_rate[level]) {
+            site->tokens = burst_tokens;
+        } else {
+            site->tokens += elapsed * level_rate[level];
+            if (site->tokens > burst_tokens) {
+                site->tokens = burst_tokens;
+            }
+        }
+    }
+
+    if (site->tokens < TOKEN_SCALE) {
+        site->suppressed++;
+        return false;
+    }
+    site->tokens -= TOKEN_SCALE;
+    *suppressed = site->suppressed;
+    site->suppressed = 0;
+
+    return true;
+}
+
+/**
+ * Get the suppressed log number of the call site whose bucket was evicted by last check, the number
+ * is cleared after get. The caller must hold the output lock.
+ *
+ * @param file the evicted call site's file name
+ * @param line the evicted call site's line number
+ *
+ * @return suppressed log number, 0: no suppressed log is evicted
+ */
+size_t elog_rate_limit_get_evicted(const char **file, long *line) {
+    size_t suppressed = evicted_suppressed;
+
+    *file = evicted_file;
+    *line = evicted_line;
+    evicted_suppressed = 0;
+
+    return suppressed;
+}
+
+/**
+ * load the default burst and rate setting for all levels
+ */
+static void load_default_setting(void) {
+    uint8_t i;
+
+    for (i = 0; i <= ELOG_LVL_VERBOSE; i++) {
+        level_burst[i] = ELOG_RATE_LIMIT_BURST;
+        level_rate[i] = ELOG_RATE_LIMIT_RATE;
+    }
+    init_ok = true;
+}
+
+/**
+ * Find the bucket for the call site by linear probing. When all buckets are used, the least recently
+ * used one is evicted for the new call site. The bucket is never freed, so the probing chain isn't broken.
+ *
+ * @param file file name
+ * @param line line number
+ * @param now current time
+ *
+ * @return bucket, it's free (file is NULL) for the new call site
+ */
+static ElogRateSite_t find_site(const char *file, long line, uint32_t now) {
+    size_t i, index = ((size_t) file + (size_t) line) % ELOG_RATE_LIMIT_SITE_MAX, lru = index;
+
+    for (i = 0; i < ELOG_RATE_LIMIT_SITE_MAX; i++) {
+        if (sites[index].file == NULL || (sites[index].file == file && sites[index].line == line)) {
+            return &sites[index];
+        }
+        if (now - sites[index].last_ms > now - sites[lru].last_ms) {
+            lru = index;
+        }
+        index = (index + 1) % ELOG_RATE_LIMIT_SITE_MAX;
+    }
+    /* the evicted call site will get a full bucket when it comes back, it's suppressed logs are reported now */
+    evicted_file = sites[lru].file;
+    evicted_line = sites[lru].line;
+    evicted_suppressed = sites[lru].suppressed;
+    sites[lru].file = NULL;
+    sites[lru].suppressed = 0;
+
+    return &sites[lru];
+}
+
+#endif /* ELOG_USING_RATE_LIMIT */
@@ -0,0 +1,192 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Log sampling. Only 1 in N logs or 1 log in a period is output for a tag or a call site.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+#include <string.h>
+
+#ifdef ELOG_USING_SAMPLE
+
+/* sampling rule */
+typedef struct {
+    char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
+    /* call site line number, 0: all call sites of the tag */
+    long line;
+    /* call site file name hash, the rule matches any file when has_file is false */
+    bool has_file;
+    uint32_t file_hash;
+    /* the matched file name address, so the file name needn't hash again. the file name of log is always
+     * a string literal (ELOG_FILE), so it's content isn't changed */
+    const char *file_addr;
+    /* output 1 in rate logs, it's used when the period is 0 */
+    uint32_t rate;
+    /* output 1 log in period (ms) */
+    uint32_t period;
+    /* the dropped log number since last output */
+    uint32_t dropped;
+    uint32_t last_ms;
+    /* the first log has been output */
+    bool started;
+    bool used;
+} ElogSampleRule, *ElogSampleRule_t;
+
+static ElogSampleRule rules[ELOG_SAMPLE_RULE_MAX];
+static size_t rule_num = 0;
+
+static bool file_match(ElogSampleRule_t rule, const char *file);
+
+/**
+ * Set the sampling rule for a tag or a call site. The rule will be removed when rate is 0 or 1 and period is 0.
+ *
+ * @param tag tag
+ * @param file call site file name which is same as the log (ELOG_FILE), NULL: any file. it's used with line.
+ * @param line call site line number with this tag, 0: all call sites of the tag
+ * @param rate output 1 in rate logs, it's used when the period is 0
+ * @param period output 1 log in period (ms)
+ *
+ * @return false: the rule table is full
+ */
+bool elog_set_sample(const char *tag, const char *file, long line, uint32_t rate, uint32_t period) {
+    ElogSampleRule_t rule = NULL;
+    bool remove = rate <= 1 && period == 0, has_file = file && line;
+    uint32_t file_hash = has_file ? elog_hash(ELOG_HASH_INIT, file, strlen(file)) : 0;
+    size_t i;
+
+    ELOG_ASSERT(tag);
+    ELOG_ASSERT(strlen(tag) <= ELOG_FILTER_TAG_MAX_LEN);
+
+    /* lock output */
+    elog_port_output_lock();
+
+    /* find the same rule or a free rule */
+    for (i = 0; i < ELOG_SAMPLE_RULE_MAX; i++) {
+        if (rules[i].used && rules[i].line == line && rules[i].has_file == has_file
+                && rules[i].file_hash == file_hash && !strcmp(rules[i].tag, tag)) {
+            rule = &rules[i];
+            break;
+        } else if (!rules[i].used && !rule) {
+            rule = &rules[i];
+        }
+    }
+
+    if (remove) {
+        if (rule && rule->used) {
+            rule->used = false;
+            rule_num--;
+        }
+    } else if (rule) {
+        if (!rule->used) {
+            strcpy(rule->tag, tag);
+            rule->line = line;
+            rule->has_file = has_file;
+            rule->file_hash = file_hash;
+            rule->file_addr = NULL;
+            rule->used = true;
+            rule_num++;
+        }
+        rule->rate = rate;
+        rule->period = period;
+        rule->dropped = 0;
+        rule->started = false;
+    }
+
+    /* unlock output */
+    elog_port_output_unlock();
+
+    return remove || rule != NULL;
+}
+
+/**
+ * Check the log should be sampled or not. It's checked before the log is formatted.
+ * The call site rule is higher priority than the tag rule.
+ * The caller must hold the output lock.
+ *
+ * @param tag tag
+ * @param file file name
+ * @param line line number
+ * @param sample the log number since last output include this log, 1: the log isn't sampled
+ *
+ * @return true: can output, false: this log should be dropped
+ */
+bool elog_sample_check(const char *tag, const char *file, long line, uint32_t *sample) {
+    ElogSampleRule_t rule = NULL;
+    uint32_t now;
+    size_t i;
+    bool output;
+
+    *sample = 1;
+
+    /* there is no rule, it's the most case */
+    if (rule_num == 0) {
+        return true;
+    }
+
+    for (i = 0; i < ELOG_SAMPLE_RULE_MAX; i++) {
+        if (rules[i].used && ((rules[i].line == line && file_match(&rules[i], file)) || (rules[i].line == 0 && !rule))
+                && !strcmp(rules[i].tag, tag)) {
+            rule = &rules[i];
+            if (rule->line) {
+                break;
+            }
+        }
+    }
+    if (!rule) {
+        return true;
+    }
+
+    now = elog_port_get_ms();
+    if (rule->period) {
+        output = !rule->started || now - rule->last_ms >= rule->period;
+    } else {
+        output = !rule->started || rule->dropped + 1 >= rule->rate;
+    }
+    if (!output) {
+        rule->dropped++;
+        return false;
+    }
+    *sample = rule->dropped + 1;
+    rule->dropped = 0;
+    rule->last_ms = now;
+    rule->started = true;
+
+    return true;
+}
+
+/**
+ * check the call site file name is matched with the rule
+ *
+ * @param rule sampling rule
+ * @param file file name
+ *
+ * @return true: matched
+ */
+static bool file_match(ElogSampleRule_t rule, const char *file) {
+    if (!rule->has_file || rule->file_addr == file) {
+        return true;
+    } else if (elog_hash(ELOG_HASH_INIT, file, strlen(file)) == rule->file_hash) {
+        rule->file_addr = file;
+        return true;
+    }
+
+    return false;
+}
+
+#endif /* ELOG_USING_SAMPLE */
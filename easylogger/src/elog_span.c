@@ -0,0 +1,117 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Timing span. The cycles of a code region is measured by cycle counter, and it's output as
+ *           log line or compact record when the region ends.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+#include <stdio.h>
+
+#ifdef ELOG_USING_SPAN
+
+/* the max span record length */
+#define SPAN_RECORD_MAX_LEN                  128
+
+/**
+ * Begin the span. The span will be disabled when it's filtered by level and tag, then the end of it
+ * costs nothing.
+ *
+ * @param span span, it must be valid until elog_span_end
+ * @param level level
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated when needed
+ * @param name span name, it must be valid until elog_span_end
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ */
+void elog_span_begin(ElogSpan_t span, uint8_t level, const char *tag, const uint32_t *tag_hash, const char *name,
+        const char *file, const char *func, long line) {
+    ELOG_ASSERT(span);
+    ELOG_ASSERT(name);
+
+    span->enabled = elog_get_output_enabled() && elog_output_check(level, tag, tag_hash);
+    if (!span->enabled) {
+        return;
+    }
+
+    span->name = name;
+    span->tag = tag;
+    span->tag_hash = tag_hash;
+    span->file = file;
+    span->func = func;
+    span->line = line;
+    span->level = level;
+    span->parent = elog_port_get_span();
+    span->depth = span->parent ? span->parent->depth + 1 : 0;
+    elog_port_set_span(span);
+    /* the cycle count is taken at last, so the span itself isn't measured */
+    span->start = elog_port_get_cycle();
+}
+
+/**
+ * End the span and output it. The spans in a thread must be ended in reverse order of begin.
+ *
+ * @param span span
+ */
+void elog_span_end(ElogSpan_t span) {
+    uint32_t cycles;
+#ifdef ELOG_SPAN_USING_RECORD
+    char record[SPAN_RECORD_MAX_LEN];
+#endif
+
+    if (!span->enabled) {
+        return;
+    }
+
+    cycles = elog_port_get_cycle() - span->start;
+    elog_port_set_span(span->parent);
+    span->enabled = false;
+
+#ifdef ELOG_SPAN_USING_RECORD
+    /* the record is output as the log text, so it's saved to crash log, flight recorder and so on as the
+     * other logs. the name is truncated when the record is too long. */
+    if (snprintf(record, sizeof(record), "[elog span] start=%08lx cycles=%lu depth=%u thread=%s tag=%s name=%s",
+            (unsigned long) span->start, (unsigned long) cycles, span->depth, elog_port_get_t_info(), span->tag,
+            span->name) <= 0) {
+        return;
+    }
+    elog_output_str(span->level, span->tag, span->tag_hash, span->file, span->func, span->line, record);
+#else
+    if (span->tag_hash) {
+        elog_output_hash(span->level, span->tag, *span->tag_hash, span->file, span->func, span->line,
+                "%*s%s: %lu cycles", span->depth * 2, "", span->name, (unsigned long) cycles);
+    } else {
+        elog_output(span->level, span->tag, span->file, span->func, span->line, "%*s%s: %lu cycles",
+                span->depth * 2, "", span->name, (unsigned long) cycles);
+    }
+#endif /* ELOG_SPAN_USING_RECORD */
+}
+
+/**
+ * end the span when it's out of scope, it's used by ELOG_SPAN
+ *
+ * @param span span
+ */
+void elog_span_cleanup(ElogSpan_t span) {
+    elog_span_end(span);
+}
+
+#endif /* ELOG_USING_SPAN */
@@ -0,0 +1,320 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Tag table. The tag is interned to a numeric ID, so the filter needn't string compare.
+ * Created on: 2026-10-19
+ *
+ * The tag is identified by it's hash value, and the tag string address is cached to the ID,
+ * so the same tag string in different files has the same ID, and the hot path is only an
+ * address compare, an array index and a short compare with the tag name which is copied to table,
+ * so the tag in a reused buffer is never mapped to the wrong ID. The tag string is only hashed on
+ * first use of an address, and the C++ tag (elog.hpp) is hashed at compile time, so it's never
+ * hashed at runtime. The tag which is longer than ELOG_FILTER_TAG_MAX_LEN isn't interned.
+ */
+
+#include "elog.h"
+#include <string.h>
+
+#ifdef ELOG_USING_TAG_TABLE
+
+/* tag address cache size, it's a direct-mapped cache */
+#define TAG_CACHE_SIZE                       (ELOG_TAG_MAX_NUM * 2)
+/* the tag address cache index */
+#define TAG_CACHE_INDEX(tag)                 ((((size_t) (tag)) >> 2) % TAG_CACHE_SIZE)
+/* memory fence for the cache entry sequence, the volatile access order is enough on single core */
+#if defined(__GNUC__) || defined(__clang__)
+#define TAG_CACHE_FENCE()                    __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#else
+#define TAG_CACHE_FENCE()
+#endif
+
+/* interned tag */
+typedef struct {
+    uint32_t hash;
+    /* tag name */
+    char name[ELOG_FILTER_TAG_MAX_LEN + 1];
+    /* output level, ELOG_TAG_LVL_DEFAULT: using global filter level */
+    uint8_t level;
+    /* tag filter match result and it's filter generation */
+    bool match;
+    uint32_t match_gen;
+} ElogTag, *ElogTag_t;
+
+/* tag address cache entry */
+typedef struct {
+    /* it's odd when the entry is being changed */
+    volatile uint32_t seq;
+    const char *volatile addr;
+    volatile uint8_t id;
+} ElogTagCache, *ElogTagCache_t;
+
+static ElogTag tags[ELOG_TAG_MAX_NUM];
+static volatile size_t tag_num = 0;
+static ElogTagCache tag_cache[TAG_CACHE_SIZE];
+/* it will be changed when the tag filter is changed, then the cached match result will be expired */
+static volatile uint32_t filter_gen = 1;
+
+static bool tag_valid(const char *tag);
+static uint8_t find_id(uint32_t hash);
+static uint8_t intern(uint32_t hash, const char *tag);
+static bool cache_find(const char *tag, uint8_t *id);
+static void cache_id(const char *tag, uint8_t id);
+
+/**
+ * Get the tag ID. The tag will be interned when it's used first time.
+ *
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated from the tag string
+ *
+ * @return tag ID, ELOG_TAG_ID_INVALID: the tag table is full
+ */
+uint8_t elog_tag_get_id(const char *tag, const uint32_t *tag_hash) {
+    uint32_t hash;
+    uint8_t id;
+
+    /* hot path */
+    if (cache_find(tag, &id)) {
+        return id;
+    }
+    if (!tag_valid(tag)) {
+        return ELOG_TAG_ID_INVALID;
+    }
+
+    hash = tag_hash ? *tag_hash : elog_hash(ELOG_HASH_INIT, tag, strlen(tag));
+
+    /* lock output */
+    elog_port_output_lock();
+
+    id = intern(hash, tag);
+    if (id != ELOG_TAG_ID_INVALID) {
+        cache_id(tag, id);
+    }
+
+    /* unlock output */
+    elog_port_output_unlock();
+
+    return id;
+}
+
+/**
+ * Find the tag ID without intern, it is lock free and can be called in ISR.
+ *
+ * @param tag tag
+ * @param tag_hash tag hash value, NULL: it will be calculated from the tag string
+ *
+ * @return tag ID, ELOG_TAG_ID_INVALID: the tag is not interned
+ */
+uint8_t elog_tag_find_id(const char *tag, const uint32_t *tag_hash) {
+    uint8_t id;
+
+    if (cache_find(tag, &id)) {
+        return id;
+    }
+    if (!tag_valid(tag)) {
+        return ELOG_TAG_ID_INVALID;
+    }
+    id = find_id(tag_hash ? *tag_hash : elog_hash(ELOG_HASH_INIT, tag, strlen(tag)));
+    /* the hash value maybe collided */
+    if (id != ELOG_TAG_ID_INVALID && strcmp(tags[id].name, tag)) {
+        id = ELOG_TAG_ID_INVALID;
+    }
+
+    return id;
+}
+
+/**
+ * Check the log can be output or not by the tag's level and tag filter.
+ *
+ * @param id tag ID
+ * @param level log level
+ * @param default_lvl the level when the tag's level is not set
+ * @param filter_tag tag filter
+ *
+ * @return true: the log can be output
+ */
+bool elog_tag_check(uint8_t id, uint8_t level, uint8_t default_lvl, const char *filter_tag) {
+    ElogTag_t t = &tags[id];
+    uint32_t gen = filter_gen;
+
+    if (level > (t->level == ELOG_TAG_LVL_DEFAULT ? default_lvl : t->level)) {
+        return false;
+    }
+    /* the tag filter is only matched once after it is changed */
+    if (t->match_gen != gen) {
+        t->match = strstr(t->name, filter_tag) != NULL;
+        t->match_gen = gen;
+    }
+
+    return t->match;
+}
+
+/**
+ * expire all tag filter match result, it should be called when the tag filter is changed
+ */
+void elog_tag_filter_changed(void) {
+    filter_gen++;
+}
+
+/**
+ * Set the output level for a tag. It's higher priority than the global filter level.
+ * The tag string can be a temporary buffer, it's copied to the tag table.
+ *
+ * @param tag tag
+ * @param level level, ELOG_TAG_LVL_DEFAULT: using global filter level
+ *
+ * @return false: the tag table is full
+ */
+bool elog_set_tag_lvl(const char *tag, uint8_t level) {
+    uint8_t id;
+
+    ELOG_ASSERT(tag);
+    ELOG_ASSERT(strlen(tag) <= ELOG_FILTER_TAG_MAX_LEN);
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE || level == ELOG_TAG_LVL_DEFAULT);
+
+    /* lock output */
+    elog_port_output_lock();
+
+    id = intern(elog_hash(ELOG_HASH_INIT, tag, strlen(tag)), tag);
+    if (id != ELOG_TAG_ID_INVALID) {
+        tags[id].level = level;
+    }
+
+    /* unlock output */
+    elog_port_output_unlock();
+
+    return id != ELOG_TAG_ID_INVALID;
+}
+
+/**
+ * get the output level for a tag
+ *
+ * @param tag tag
+ *
+ * @return level, ELOG_TAG_LVL_DEFAULT: using global filter level
+ */
+uint8_t elog_get_tag_lvl(const char *tag) {
+    uint8_t id = find_id(elog_hash(ELOG_HASH_INIT, tag, strlen(tag)));
+
+    return id == ELOG_TAG_ID_INVALID ? ELOG_TAG_LVL_DEFAULT : tags[id].level;
+}
+
+/**
+ * check the tag length, the tag which is longer than ELOG_FILTER_TAG_MAX_LEN can't be interned
+ *
+ * @param tag tag
+ *
+ * @return true: the tag can be interned
+ */
+static bool tag_valid(const char *tag) {
+    return memchr(tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1) != NULL;
+}
+
+/**
+ * find the tag ID by hash value
+ *
+ * @param hash tag hash value
+ *
+ * @return tag ID, ELOG_TAG_ID_INVALID: not found
+ */
+static uint8_t find_id(uint32_t hash) {
+    size_t i, num = tag_num;
+
+    for (i = 0; i < num; i++) {
+        if (tags[i].hash == hash) {
+            return (uint8_t) i;
+        }
+    }
+
+    return ELOG_TAG_ID_INVALID;
+}
+
+/**
+ * Intern the tag. The tag will be added to table when it's not found.
+ * The caller must hold the output lock.
+ *
+ * @param hash tag hash value
+ * @param tag tag, it's length must be less than or equal to ELOG_FILTER_TAG_MAX_LEN
+ *
+ * @return tag ID, ELOG_TAG_ID_INVALID: the tag table is full or the hash value is collided
+ */
+static uint8_t intern(uint32_t hash, const char *tag) {
+    uint8_t id = find_id(hash);
+    ElogTag_t t;
+
+    if (id == ELOG_TAG_ID_INVALID) {
+        if (tag_num >= ELOG_TAG_MAX_NUM) {
+            return ELOG_TAG_ID_INVALID;
+        }
+        id = (uint8_t) tag_num;
+        t = &tags[id];
+        t->hash = hash;
+        strcpy(t->name, tag);
+        t->level = ELOG_TAG_LVL_DEFAULT;
+        t->match_gen = 0;
+        /* the new tag can be found after it is initialized */
+        tag_num++;
+    } else if (strcmp(tags[id].name, tag)) {
+        return ELOG_TAG_ID_INVALID;
+    }
+
+    return id;
+}
+
+/**
+ * Find the tag ID in cache, it is lock free. The entry's sequence is checked before and after it's
+ * read, so the address and ID which are being changed are never used. The tag name is compared at
+ * last, because the tag buffer maybe reused by another tag.
+ *
+ * @param tag tag string address
+ * @param id tag ID
+ *
+ * @return true: the tag is found
+ */
+static bool cache_find(const char *tag, uint8_t *id) {
+    ElogTagCache_t cache = &tag_cache[TAG_CACHE_INDEX(tag)];
+    uint32_t seq = cache->seq;
+    const char *addr;
+
+    TAG_CACHE_FENCE();
+    addr = cache->addr;
+    *id = cache->id;
+    TAG_CACHE_FENCE();
+
+    return !(seq & 1) && seq == cache->seq && addr == tag
+            && !strncmp(tags[*id].name, tag, ELOG_FILTER_TAG_MAX_LEN + 1);
+}
+
+/**
+ * Cache the tag address to ID. The entry's sequence is odd when it's being changed.
+ * The caller must hold the output lock.
+ *
+ * @param tag tag string address
+ * @param id tag ID
+ */
+static void cache_id(const char *tag, uint8_t id) {
+    ElogTagCache_t cache = &tag_cache[TAG_CACHE_INDEX(tag)];
+
+    cache->seq++;
+    TAG_CACHE_FENCE();
+    cache->addr = tag;
+    cache->id = id;
+    TAG_CACHE_FENCE();
+    cache->seq++;
+}
+
+#endif /* ELOG_USING_TAG_TABLE */
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Function: Adaptive throttling. The output level is limited step by step when the output backlog
+ *           is high, and it's restored step by step when the backlog is drained.
+ * Created on: 2026-10-19
+ */
+
+#include "elog.h"
+
+#ifdef ELOG_USING_THROTTLE
+
+/* the current max output level */
+static uint8_t throttle_lvl = ELOG_LVL_VERBOSE;
+/* the last level transition time */
+static uint32_t last_ms = 0;
+/* the dropped log number since last level transition */
+static size_t dropped_num = 0;
+
+/**
+ * Update the output level by output backlog. The level is changed one step at most in
+ * ELOG_THROTTLE_INTERVAL, so it won't change too fast.
+ * The caller must hold the output lock.
+ *
+ * @param dropped the dropped log number since last level transition
+ *
+ * @return true: the level has been changed, it can be got by elog_throttle_get_lvl
+ */
+bool elog_throttle_update(size_t *dropped) {
+    uint8_t backlog = elog_port_get_backlog();
+    uint32_t now;
+
+    /* the backlog is normal, it's the most case */
+    if ((backlog < ELOG_THROTTLE_HIGH_WATERMARK || throttle_lvl <= ELOG_THROTTLE_MIN_LVL)
+            && (backlog > ELOG_THROTTLE_LOW_WATERMARK || throttle_lvl == ELOG_LVL_VERBOSE)) {
+        return false;
+    }
+
+    now = elog_port_get_ms();
+    if (now - last_ms < ELOG_THROTTLE_INTERVAL) {
+        return false;
+    }
+    last_ms = now;
+
+    if (backlog >= ELOG_THROTTLE_HIGH_WATERMARK) {
+        throttle_lvl--;
+    } else {
+        throttle_lvl++;
+    }
+    *dropped = dropped_num;
+    dropped_num = 0;
+
+    return true;
+}
+
+/**
+ * Check the log can be output by current limited level or not.
+ * The caller must hold the output lock.
+ *
+ * @param level level
+ *
+ * @return true: can output, false: this log should be dropped
+ */
+bool elog_throttle_check(uint8_t level) {
+    if (level > throttle_lvl) {
+        dropped_num++;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * get the current max output level
+ *
+ * @return level, ELOG_LVL_VERBOSE: it isn't limited
+ */
+uint8_t elog_throttle_get_lvl(void) {
+    return throttle_lvl;
+}
+
+#endif /* ELOG_USING_THROTTLE */
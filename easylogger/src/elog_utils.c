@@ -21,6 +21,10 @@
  */
 
 #include "elog.h"
+#include <string.h>
+
+/* the next global sequence number */
+static volatile uint64_t seq = 0;
 
 /**
  * another copy string function
@@ -43,3 +47,117 @@ size_t elog_strcpy(size_t cur_len, char *dst, const char *src) {
     }
     return src - src_old;
 }
+
+/**
+ * FNV-1a hash function. it can be called continuously by the last hash value.
+ *
+ * @param hash last hash value, the first time must be ELOG_HASH_INIT
+ * @param data data
+ * @param size data size
+ *
+ * @return hash value
+ */
+uint32_t elog_hash(uint32_t hash, const void *data, size_t size) {
+    const uint8_t *p = (const uint8_t *) data;
+
+    while (size--) {
+        hash ^= *p++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * Get the next global sequence number. It's taken by one atomic increment, so the logs from
+ * all threads and CPUs can be ordered by it, and the dropped logs can be found by the gap.
+ * When the compiler has no 64 bits atomic operation, such as Cortex-M, the interrupt is disabled
+ * if the port has implemented the interrupt interface (ELOG_PORT_USING_IRQ), otherwise it's a plain
+ * increment which is protected by the caller's logger lock.
+ *
+ * @return sequence number, it's start from 0
+ */
+uint64_t elog_seq_next(void) {
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+    return __atomic_fetch_add(&seq, 1, __ATOMIC_RELAXED);
+#elif defined(ELOG_PORT_USING_IRQ)
+    uint64_t value;
+    uint32_t irq_level;
+
+    irq_level = elog_port_irq_disable();
+    value = seq++;
+    elog_port_irq_enable(irq_level);
+
+    return value;
+#else
+    return seq++;
+#endif
+}
+
+/**
+ * write data to log ring buffer. the oldest data will be overwritten when it's full.
+ *
+ * @param ring ring buffer
+ * @param data data
+ * @param size data size
+ */
+void elog_ring_write(ElogRing_t ring, const char *data, size_t size) {
+    size_t copy_size;
+
+    /* only the newest data will be saved when it is larger than ring buffer */
+    if (size > ring->size) {
+        data += size - ring->size;
+        size = ring->size;
+    }
+    while (size) {
+        copy_size = ring->size - ring->write_pos;
+        if (copy_size > size) {
+            copy_size = size;
+        }
+        memcpy(ring->buf + ring->write_pos, data, copy_size);
+        ring->write_pos += copy_size;
+        if (ring->write_pos >= ring->size) {
+            ring->write_pos = 0;
+            ring->full = true;
+        }
+        data += copy_size;
+        size -= copy_size;
+    }
+}
+
+/**
+ * Output the newest data in log ring buffer by elog_port_output.
+ * The output will start from a new line, so the first incomplete log will be skipped.
+ *
+ * @param ring ring buffer
+ * @param size max output size, 0: output all data
+ */
+void elog_ring_output(ElogRing_t ring, size_t size) {
+    size_t used = ring->full ? ring->size : ring->write_pos, start, first_size;
+
+    if (size == 0 || size > used) {
+        size = used;
+    }
+    start = (ring->write_pos + ring->size - size) % ring->size;
+    /* skip the incomplete log */
+    if (size < used || ring->full) {
+        while (size && ring->buf[start] != '\n') {
+            start = (start + 1) % ring->size;
+            size--;
+        }
+        if (size) {
+            start = (start + 1) % ring->size;
+            size--;
+        }
+    }
+    if (size == 0) {
+        return;
+    }
+    /* the data maybe is divided into two parts */
+    first_size = ring->size - start;
+    if (first_size >= size) {
+        elog_port_output(ring->buf + start, size);
+    } else {
+        elog_port_output(ring->buf + start, first_size);
+        elog_port_output(ring->buf, size - first_size);
+    }
+}
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+#
+# This file is part of the EasyLogger Library.
+#
+# Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Function: Cycle counter timestamp tool. It converts the cycle count (@xxxxxxxx) which is output by
+#           ELOG_FMT_CYCLE to time by the calibration points ([elog calib] cycle=xxxxxxxx ms=N).
+# Created on: 2026-10-19
+#
+# Usage:
+#
+#     elog_cycle.py [-f frequency] [-k] [input file]
+#         Convert the cycle count in log from input file (default: stdin) to "[seconds.nanoseconds]".
+#         The counter frequency is measured by the calibration points when it isn't specified, and
+#         the logs are held until the second calibration point is read. The calibration point is only
+#         output with log, so the counter maybe wrapped many times between two points when there is no
+#         log, the wrap count is resolved by the elapsed milliseconds.
+#         For example: cat /dev/ttyUSB0 | elog_cycle.py -f 72000000
+#
+
+import argparse
+import re
+import sys
+
+CALIB_RE = re.compile(rb'\[elog calib\] cycle=([0-9a-f]{8}) ms=(\d+)')
+CYCLE_RE = re.compile(rb'(^|(?<=\s))@([0-9a-f]{8}) ')
+# the cycle counter wraps around at 32 bits
+WRAP = 1 << 32
+# the max relative error of measured frequency, the period which doesn't match it has wrapped counter
+CPMS_TOLERANCE = 0.1
+
+
+class Clock(object):
+    """the cycle counter clock which is calibrated by calibration points"""
+
+    def __init__(self, freq):
+        # cycles per millisecond
+        self.cpms = freq / 1000.0 if freq else None
+        self.measured = not freq
+        # the frequency is measured from this calibration point: (raw cycle, unwrapped cycle, ms)
+        self.first = None
+        # the last calibration point: (raw cycle, unwrapped cycle, ms)
+        self.last = None
+        # the shortest calibration period (ms) since the first point, it's least likely to be wrapped
+        self.short_ms = None
+
+    def calibrate(self, cycle, ms):
+        if self.last is None:
+            self.last = (cycle, cycle, ms)
+            self.first = self.last
+            return
+        raw_delta = (cycle - self.last[0]) & 0xFFFFFFFF
+        delta_ms = ms - self.last[2]
+        delta = raw_delta
+        if self.cpms and delta_ms > 0:
+            # the counter maybe wrapped many times when there is no log output, the calibration point is only
+            # output with log, so the wrap count is resolved by the elapsed time
+            delta += max(0, int(round((self.cpms * delta_ms - raw_delta) / WRAP))) * WRAP
+        if self.measured and delta_ms > 0:
+            pair_cpms = raw_delta / float(delta_ms)
+            mismatch = self.cpms is not None and abs(pair_cpms - self.cpms) > self.cpms * CPMS_TOLERANCE
+            if self.cpms is None or (delta_ms < self.short_ms and mismatch):
+                # the shorter period doesn't match the measured frequency, so the former periods maybe wrapped
+                # without calibration point, the frequency is measured from this period again
+                self.first = self.last
+                self.short_ms = delta_ms
+                self.cpms = pair_cpms
+                delta = raw_delta
+            else:
+                self.short_ms = min(self.short_ms, delta_ms)
+        self.last = (cycle, self.last[1] + delta, ms)
+        # the longer calibration period, the more accurate frequency
+        if self.measured and ms > self.first[2]:
+            self.cpms = (self.last[1] - self.first[1]) / float(ms - self.first[2])
+
+    def ready(self):
+        return self.last is not None and self.cpms is not None
+
+    def convert(self, cycle):
+        """convert the cycle count to nanoseconds, the cycle maybe earlier than the last calibration point"""
+        delta = (cycle - self.last[0]) & 0xFFFFFFFF
+        if delta >= 0x80000000:
+            delta -= 0x100000000
+        return int(round((self.last[2] + delta / self.cpms) * 1000000))
+
+
+def convert_line(clock, line):
+    def replace(match):
+        ns = clock.convert(int(match.group(2), 16))
+        sign = b'-' if ns < 0 else b''
+        ns = abs(ns)
+        return b'[%s%d.%09d] ' % (sign, ns // 1000000000, ns % 1000000000)
+
+    return CYCLE_RE.sub(replace, line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='EasyLogger cycle counter timestamp tool')
+    parser.add_argument('-f', '--freq', type=float, help='cycle counter frequency (Hz), default: measured')
+    parser.add_argument('-k', '--keep', action='store_true', help='keep the calibration points in output')
+    parser.add_argument('input', nargs='?', help='input file, default: stdin')
+    args = parser.parse_args()
+
+    clock = Clock(args.freq)
+    src = open(args.input, 'rb') if args.input else sys.stdin.buffer
+    out = sys.stdout.buffer
+    pending = []
+    for line in src:
+        match = CALIB_RE.search(line)
+        if match:
+            clock.calibrate(int(match.group(1), 16), int(match.group(2)))
+            if not args.keep:
+                continue
+        if not clock.ready():
+            pending.append(line)
+            continue
+        for held in pending:
+            out.write(convert_line(clock, held))
+        pending = []
+        out.write(convert_line(clock, line))
+        out.flush()
+    # the frequency is unknown, so the cycle count is output as is
+    for held in pending:
+        out.write(held)
+    if args.input:
+        src.close()
+
+
+if __name__ == '__main__':
+    main()
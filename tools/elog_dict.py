@@ -0,0 +1,374 @@
+#!/usr/bin/env python3
+#
+# This file is part of the EasyLogger Library.
+#
+# Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Function: Dictionary log tool. It assigns ID to elog_id_a ~ elog_id_v in source files and saves
+#           the tag, format and file name to dictionary file, then decodes the binary log on host.
+# Created on: 2026-10-19
+#
+# Usage:
+#
+#     elog_dict.py update [-d elog_dict.json] <source dir or file> ...
+#         Assign ID to the new log (its ID is 0) and the duplicate ID, then update the dictionary.
+#         It should be run before each build.
+#
+#     elog_dict.py decode [-d elog_dict.json] [input file]
+#         Decode the binary log from input file (default: stdin), the text log is output as is.
+#         For example: cat /dev/ttyUSB0 | elog_dict.py decode
+#
+
+import argparse
+import codecs
+import json
+import os
+import re
+import struct
+import sys
+
+# frame sync byte, it must be same as elog_dict.c
+DICT_SYNC = 0xA5
+# max argument number, it must be same as ELOG_DICT_ARGS_MAX
+DICT_ARGS_MAX = 8
+# level name
+LEVEL_NAME = 'AEWIDV'
+# source file extension
+SOURCE_EXT = ('.c', '.h', '.cpp', '.hpp', '.cc')
+
+CALL_RE = re.compile(r'\belog_id_([aewidv])\s*\(')
+FORMAT_SPEC_RE = re.compile(r'%([-+ #0]*)(\d+|\*)?(\.\d+|\.\*)?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaAp%])')
+
+
+class ParseError(Exception):
+    pass
+
+
+def skip_space(text, pos):
+    """skip white space and comment"""
+    while pos < len(text):
+        if text[pos].isspace():
+            pos += 1
+        elif text.startswith('//', pos):
+            pos = text.find('\n', pos)
+            pos = len(text) if pos < 0 else pos
+        elif text.startswith('/*', pos):
+            pos = text.find('*/', pos)
+            pos = len(text) if pos < 0 else pos + 2
+        else:
+            break
+    return pos
+
+
+def read_string(text, pos):
+    """read the C string literal, return (raw literal content, end position)"""
+    if text[pos] != '"':
+        raise ParseError('string literal is expected')
+    end = pos + 1
+    while end < len(text) and text[end] != '"':
+        end += 2 if text[end] == '\\' else 1
+    if end >= len(text):
+        raise ParseError('string literal is not terminated')
+    return text[pos + 1:end], end + 1
+
+
+def read_expr(text, pos):
+    """read the expression until top level ',' or ')', return (expression, end position)"""
+    depth = 0
+    start = pos
+    while pos < len(text):
+        c = text[pos]
+        if c == '"' or c == "'":
+            quote = c
+            pos += 1
+            while pos < len(text) and text[pos] != quote:
+                pos += 2 if text[pos] == '\\' else 1
+        elif c in '([{':
+            depth += 1
+        elif c in ')]}':
+            if depth == 0:
+                break
+            depth -= 1
+        elif c == ',' and depth == 0:
+            break
+        pos += 1
+    return text[start:pos].strip(), pos
+
+
+def unescape(literal, encoding):
+    """convert the C string literal content (the source file is read as latin-1) to string"""
+    raw = codecs.decode(literal, 'unicode_escape').encode('latin-1')
+    return raw.decode(encoding, errors='replace')
+
+
+def resolve_tag(text, expr, encoding):
+    """the tag is a string literal, a macro or a variable which is defined in same file"""
+    if expr.startswith('"'):
+        return unescape(read_string(expr, 0)[0], encoding)
+    if re.match(r'^[A-Za-z_]\w*$', expr):
+        match = re.search(r'#\s*define\s+' + expr + r'\s+"((?:[^"\\]|\\.)*)"', text) or \
+                re.search(r'\b' + expr + r'\s*(?:\[\s*\])?\s*=\s*"((?:[^"\\]|\\.)*)"', text)
+        if match:
+            return unescape(match.group(1), encoding)
+    return expr
+
+
+def parse_call(text, pos):
+    """parse "id, tag, format" of elog_id_x(, return (id start, id end, id, tag expression, format)"""
+    id_start = skip_space(text, pos)
+    match = re.compile(r'\d+').match(text, id_start)
+    if not match:
+        raise ParseError('the ID must be integer literal')
+    id_end = match.end()
+    pos = skip_space(text, id_end)
+    if text[pos] != ',':
+        raise ParseError("',' is expected after ID")
+    tag, pos = read_expr(text, skip_space(text, pos + 1))
+    if text[pos] != ',':
+        raise ParseError("',' is expected after tag")
+    # adjacent string literals are concatenated
+    fmt = ''
+    pos = skip_space(text, pos + 1)
+    while pos < len(text) and text[pos] == '"':
+        literal, pos = read_string(text, pos)
+        fmt += literal
+        pos = skip_space(text, pos)
+    if not fmt and text[pos] != '"':
+        raise ParseError('the format must be string literal')
+    return id_start, id_end, int(match.group(0)), tag, fmt
+
+
+def source_files(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+        for root, dirs, files in os.walk(path):
+            dirs.sort()
+            for name in sorted(files):
+                if name.endswith(SOURCE_EXT):
+                    yield os.path.join(root, name)
+
+
+def update(args):
+    logs = {}
+    calls = []
+    # scan all log calls
+    for path in source_files(args.paths):
+        with open(path, 'r', encoding='latin-1', newline='') as f:
+            text = f.read()
+        for match in CALL_RE.finditer(text):
+            # skip the macro definition in elog.h
+            line_start = text.rfind('\n', 0, match.start()) + 1
+            if text[line_start:match.start()].lstrip().startswith('#'):
+                continue
+            line = text.count('\n', 0, match.start()) + 1
+            try:
+                id_start, id_end, log_id, tag, fmt = parse_call(text, match.end())
+            except (ParseError, IndexError) as e:
+                sys.stderr.write('%s:%d: warning: %s, it is skipped\n' % (path, line, e))
+                continue
+            calls.append({'path': path, 'id_start': id_start, 'id_end': id_end, 'id': log_id,
+                          'level': LEVEL_NAME[('aewidv').index(match.group(1))],
+                          'tag': resolve_tag(text, tag, args.encoding), 'format': unescape(fmt, args.encoding),
+                          'file': os.path.basename(path), 'line': line})
+            specs = [m.group(5) for m in FORMAT_SPEC_RE.finditer(unescape(fmt, args.encoding)) if m.group(5) != '%']
+            if len(specs) > DICT_ARGS_MAX:
+                sys.stderr.write('%s:%d: warning: too many arguments, max is %d\n' % (path, line, DICT_ARGS_MAX))
+            if 's' in specs:
+                sys.stderr.write('%s:%d: warning: the string argument is not supported\n' % (path, line))
+
+    # the new log and the duplicate ID will be assigned a new ID
+    used = set()
+    next_id = max([c['id'] for c in calls] + [0]) + 1
+    for call in calls:
+        if call['id'] == 0 or call['id'] in used:
+            call['id'] = next_id
+            next_id += 1
+            call['changed'] = True
+        used.add(call['id'])
+        logs[str(call['id'])] = {k: call[k] for k in ('level', 'tag', 'format', 'file', 'line')}
+
+    # write the new ID back to source files, it's from back to front, so the position isn't changed
+    changed_files = sorted(set(c['path'] for c in calls if c.get('changed')))
+    for path in changed_files:
+        with open(path, 'r', encoding='latin-1', newline='') as f:
+            text = f.read()
+        for call in sorted([c for c in calls if c['path'] == path and c.get('changed')],
+                           key=lambda c: c['id_start'], reverse=True):
+            text = text[:call['id_start']] + str(call['id']) + text[call['id_end']:]
+        with open(path, 'w', encoding='latin-1', newline='') as f:
+            f.write(text)
+
+    with open(args.dict, 'w', encoding='utf-8') as f:
+        json.dump({'version': 1, 'logs': logs}, f, ensure_ascii=False, indent=2, sort_keys=True)
+        f.write('\n')
+    print('%d logs, %d new IDs, %d files changed' % (len(calls), len([c for c in calls if c.get('changed')]),
+                                                     len(changed_files)))
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_log(fmt, argv):
+    """format the log by C format and uint32_t arguments"""
+    out = []
+    pos = 0
+    argv = list(argv)
+    for match in FORMAT_SPEC_RE.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if width == '*':
+            width = str(to_signed(argv.pop(0)) if argv else 0)
+        if precision == '.*':
+            precision = '.' + str(to_signed(argv.pop(0)) if argv else 0)
+        spec = '%' + flags + (width or '') + (precision or '')
+        if not argv:
+            out.append('<?>')
+            continue
+        value = argv.pop(0)
+        if conv in 'di':
+            out.append((spec + 'd') % to_signed(value))
+        elif conv == 'u':
+            out.append((spec + 'd') % value)
+        elif conv in 'oxX':
+            out.append((spec + conv) % value)
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(value & 0xFF))
+        elif conv in 'fFeEgG':
+            out.append((spec + conv) % struct.unpack('<f', struct.pack('<I', value))[0])
+        elif conv in 'aA':
+            out.append((spec + 'g') % struct.unpack('<f', struct.pack('<I', value))[0])
+        elif conv == 'p':
+            out.append('0x%x' % value)
+        else:
+            # the string can't be output by dictionary log
+            out.append('<str>')
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def read_varint(data, pos):
+    """read the variable length integer, return (value, end position), None: not enough data"""
+    value = 0
+    shift = 0
+    while pos < len(data):
+        byte = data[pos]
+        pos += 1
+        if byte >= 0x80:
+            value |= (byte & 0x7F) << shift
+            shift += 7
+        elif byte >= 0x40:
+            return value | ((byte & 0x3F) << shift), pos
+        else:
+            raise ParseError('bad variable length integer')
+    return None
+
+
+def parse_frame(data, pos):
+    """parse the frame at pos, return (level, id, ms, arguments, end position), None: not enough data"""
+    if pos + 1 >= len(data):
+        return None
+    head = data[pos + 1]
+    level, argc = (head >> 4) & 0x07, head & 0x0F
+    if head < 0x80 or level >= len(LEVEL_NAME) or argc > DICT_ARGS_MAX:
+        raise ParseError('bad frame head')
+    values = []
+    end = pos + 2
+    for _ in range(argc + 2):
+        result = read_varint(data, end)
+        if result is None:
+            return None
+        value, end = result
+        values.append(value)
+    if end >= len(data):
+        return None
+    if data[end] != (0x80 | (sum(data[pos + 1:end]) & 0x7F)):
+        raise ParseError('bad frame check')
+    return level, values[0], values[1], values[2:], end + 1
+
+
+def decode_frame(logs, level, log_id, ms, argv):
+    log = logs.get(str(log_id))
+    if log is None:
+        return '%s/%-10s [%d.%03d] unknown log ID %d %s' % (LEVEL_NAME[level], '?', ms // 1000, ms % 1000, log_id,
+                                                          ' '.join('0x%x' % v for v in argv))
+    return '%s/%-10s [%d.%03d] (%s:%d) %s' % (LEVEL_NAME[level], log['tag'], ms // 1000, ms % 1000, log['file'],
+                                              log['line'], format_log(log['format'], argv))
+
+
+def decode(args):
+    with open(args.dict, 'r', encoding='utf-8') as f:
+        logs = json.load(f)['logs']
+    src = open(args.input, 'rb') if args.input else sys.stdin.buffer
+    out = sys.stdout.buffer
+    data = bytearray()
+    while True:
+        chunk = src.read1(4096) if hasattr(src, 'read1') else src.read(4096)
+        data += chunk
+        pos = 0
+        while pos < len(data):
+            sync = data.find(DICT_SYNC, pos)
+            if sync < 0:
+                out.write(data[pos:])
+                pos = len(data)
+                break
+            out.write(data[pos:sync])
+            try:
+                frame = parse_frame(data, sync)
+            except ParseError:
+                # it's not a frame, such as the non-ASCII text
+                out.write(data[sync:sync + 1])
+                pos = sync + 1
+                continue
+            if frame is None:
+                pos = sync
+                break
+            level, log_id, ms, argv, pos = frame
+            out.write((decode_frame(logs, level, log_id, ms, argv) + '\r\n').encode('utf-8'))
+        del data[:pos]
+        out.flush()
+        if not chunk:
+            break
+    if data:
+        out.write(data)
+    if args.input:
+        src.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='EasyLogger dictionary log tool')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+    cmd = sub.add_parser('update', help='assign log ID and update the dictionary')
+    cmd.add_argument('-d', '--dict', default='elog_dict.json', help='dictionary file')
+    cmd.add_argument('-e', '--encoding', default='utf-8', help='source file encoding, such as gbk')
+    cmd.add_argument('paths', nargs='+', help='source directories or files')
+    cmd.set_defaults(func=update)
+    cmd = sub.add_parser('decode', help='decode the binary log')
+    cmd.add_argument('-d', '--dict', default='elog_dict.json', help='dictionary file')
+    cmd.add_argument('input', nargs='?', help='input file, default: stdin')
+    cmd.set_defaults(func=decode)
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
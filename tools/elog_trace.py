@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+#
+# This file is part of the EasyLogger Library.
+#
+# Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Function: Trace export tool. It converts the span records (ELOG_SPAN_USING_RECORD) and the logs with
+#           cycle count (ELOG_FMT_CYCLE) to Chrome Trace Event JSON, which can be opened by
+#           chrome://tracing or https://ui.perfetto.dev to view the spans and logs on timeline per thread.
+# Created on: 2026-10-19
+#
+# Usage:
+#
+#     elog_trace.py [-f frequency] [-t] [-o output file] [input file]
+#         Convert the log from input file (default: stdin) to trace JSON (default: stdout).
+#         The cycle count is converted to time by the calibration points (ELOG_USING_CYCLE) or the
+#         frequency. The log without cycle count is ignored. The logs are in one thread by default,
+#         when ELOG_FMT_T_INFO is enabled, using -t to take the last word in "[...]" as thread.
+#         The events are written while reading, the trace is still valid when the capture is
+#         interrupted, because the trace viewer accepts the JSON array without "]".
+#         For example: cat /dev/ttyUSB0 | elog_trace.py -o trace.json
+#
+
+import argparse
+import json
+import re
+import sys
+
+from elog_cycle import CALIB_RE, Clock
+
+SPAN_RE = re.compile(r'\[elog span\] start=([0-9a-f]{8}) cycles=(\d+) depth=(\d+) thread=(\S*) tag=(\S*) name=(.*)$')
+LOG_RE = re.compile(r'^(?:#(\d+) )?@([0-9a-f]{8}) (?:([AEWIDV])/(\S+)\s+)?(?:\[([^\]]*)\] )?(?:\([^)]*\))?: ?(.*)$')
+# the thread name of the log without thread info
+DEFAULT_THREAD = 'main'
+# the trace process ID, all threads are in one process
+TRACE_PID = 1
+# the max event name length of log, the whole log is in event arguments
+LOG_NAME_MAX_LEN = 64
+
+
+class TraceWriter(object):
+    """write the trace events to JSON array one by one"""
+
+    def __init__(self, out):
+        self.out = out
+        self.count = 0
+        # thread name to trace thread ID
+        self.threads = {}
+        self.out.write('[\n')
+
+    def tid(self, thread):
+        if thread not in self.threads:
+            self.threads[thread] = len(self.threads) + 1
+            self.write({'name': 'thread_name', 'ph': 'M', 'pid': TRACE_PID, 'tid': self.threads[thread],
+                        'args': {'name': thread}})
+        return self.threads[thread]
+
+    def write(self, event):
+        if self.count:
+            self.out.write(',\n')
+        self.out.write(json.dumps(event, separators=(',', ':')))
+        self.count += 1
+
+    def close(self):
+        self.out.write('\n]\n')
+        self.out.flush()
+
+
+def parse_line(line):
+    """parse the span record or log, return (kind, cycle, fields) or None"""
+    match = SPAN_RE.search(line)
+    if match:
+        return 'span', int(match.group(1), 16), match
+    match = LOG_RE.match(line)
+    if match:
+        return 'log', int(match.group(2), 16), match
+    return None
+
+
+def write_event(writer, clock, t_info, kind, cycle, match):
+    ts = clock.convert(cycle) / 1000.0
+    if kind == 'span':
+        dur = int(match.group(2)) / clock.cpms * 1000.0
+        writer.write({'name': match.group(6), 'cat': match.group(5), 'ph': 'X', 'ts': round(ts, 3),
+                      'dur': round(dur, 3), 'pid': TRACE_PID, 'tid': writer.tid(match.group(4) or DEFAULT_THREAD),
+                      'args': {'depth': int(match.group(3))}})
+    else:
+        # the last word in "[...]" maybe is time or process info when the thread info isn't output
+        info = match.group(5).split() if t_info and match.group(5) else None
+        thread = info[-1] if info else DEFAULT_THREAD
+        msg = match.group(6)
+        args = {'log': msg}
+        if match.group(3):
+            args['level'] = match.group(3)
+        if match.group(1):
+            args['seq'] = int(match.group(1))
+        writer.write({'name': msg[:LOG_NAME_MAX_LEN], 'cat': match.group(4) or 'log', 'ph': 'i', 's': 't',
+                      'ts': round(ts, 3), 'pid': TRACE_PID, 'tid': writer.tid(thread), 'args': args})
+
+
+def main():
+    parser = argparse.ArgumentParser(description='EasyLogger trace export tool')
+    parser.add_argument('-f', '--freq', type=float, help='cycle counter frequency (Hz), default: measured')
+    parser.add_argument('-t', '--thread', action='store_true',
+                        help='the last word in "[...]" of log is thread info (ELOG_FMT_T_INFO)')
+    parser.add_argument('-o', '--output', help='output trace JSON file, default: stdout')
+    parser.add_argument('input', nargs='?', help='input file, default: stdin')
+    args = parser.parse_args()
+
+    clock = Clock(args.freq)
+    src = open(args.input, 'r', errors='replace') if args.input else sys.stdin
+    out = open(args.output, 'w', buffering=64 * 1024) if args.output else sys.stdout
+    writer = TraceWriter(out)
+    pending = []
+    for line in src:
+        line = line.rstrip('\r\n')
+        match = CALIB_RE.search(line.encode())
+        if match:
+            clock.calibrate(int(match.group(1), 16), int(match.group(2)))
+            continue
+        event = parse_line(line)
+        if not event:
+            continue
+        # the frequency is specified and there is no calibration point, the first record is the time origin
+        if args.freq and not clock.ready():
+            clock.calibrate(event[1], 0)
+        if not clock.ready():
+            pending.append(event)
+            continue
+        for held in pending:
+            write_event(writer, clock, args.thread, *held)
+        pending = []
+        write_event(writer, clock, args.thread, *event)
+    if pending:
+        sys.stderr.write('%d events are dropped, the cycle counter frequency is unknown, please use -f\n'
+                         % len(pending))
+    writer.close()
+    if args.input:
+        src.close()
+    if args.output:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()